@@ -22,6 +22,10 @@ find_required_library(CURL 7.88.1)
 find_required_library(nlohmann_json 3.11.2)
 find_required_library(hiredis 1.1.0)
 
+if(ENABLE_SIMDJSON)
+    find_required_library(simdjson 3.2.0)
+endif()
+
 if(BUILD_TESTS)
     find_required_library(Catch2 3.3.0)
 endif()
@@ -4,6 +4,7 @@
 #include "../common/response_builder.hpp"
 #include "../../core/event/event.hpp"
 #include "../../core/room/room.hpp"
+#include "../../core/stream_token.hpp"
 #include "../../core/user/user.hpp"
 #include <memory>
 #include <unordered_map>
@@ -98,6 +99,7 @@ private:
     bool user_can_kick(const RoomID& room_id, const UserID& user_id);
     bool user_can_redact(const RoomID& room_id, const UserID& user_id);
     bool user_is_in_room(const RoomID& room_id, const UserID& user_id);
+    core::PowerLevelTablePtr power_table_for(const RoomID& room_id);
 
     std::shared_ptr<core::Event> parse_event(const nlohmann::json& data, const RoomID& room_id, const UserID& sender);
     bool validate_event(const std::shared_ptr<core::Event>& event);
@@ -105,19 +107,19 @@ private:
 
     nlohmann::json build_sync_response(const UserID& user_id, const SyncParams& params);
     nlohmann::json build_room_sync(const RoomID& room_id, const UserID& user_id, bool full_state);
-    nlohmann::json build_timeline_events(const RoomID& room_id, const std::string& since_token);
+    nlohmann::json build_timeline_events(const RoomID& room_id, const core::StreamToken& since);
     nlohmann::json build_state_events(const RoomID& room_id);
     nlohmann::json build_ephemeral_events(const RoomID& room_id, const UserID& user_id);
     nlohmann::json build_account_data(const UserID& user_id);
     nlohmann::json build_presence_data(const UserID& user_id);
     nlohmann::json build_to_device_events(const UserID& user_id);
 
-    bool apply_filter(const nlohmann::json& filter, const std::shared_ptr<core::Event>& event);
+    bool apply_filter(const nlohmann::json& filter, const core::Event& event);
     nlohmann::json load_filter(const std::string& filter_id, const UserID& user_id);
     std::string save_filter(const nlohmann::json& filter, const UserID& user_id);
 
-    std::string generate_pagination_token(const std::vector<std::string>& events);
-    std::vector<std::string> parse_pagination_token(const std::string& token);
+    std::string generate_pagination_token(const core::StreamToken& position);
+    std::optional<core::StreamToken> parse_pagination_token(const std::string& token);
     nlohmann::json paginate_events(const std::vector<std::shared_ptr<core::Event>>& events,
                                   const PaginationParams& params);
 
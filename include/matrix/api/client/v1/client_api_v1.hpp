@@ -4,6 +4,7 @@
 #include "../../common/response_builder.hpp"
 #include "../../../core/event/event.hpp"
 #include "../../../core/room/room.hpp"
+#include "../../../core/stream_token.hpp"
 #include "../../../core/user/user.hpp"
 #include <memory>
 
@@ -108,7 +109,7 @@ private:
     std::string generate_event_id_v1();
     nlohmann::json build_sync_response_v1(const UserID& user_id, const SyncParams& params);
     nlohmann::json build_room_sync_v1(const RoomID& room_id, const UserID& user_id, bool full_state);
-    nlohmann::json build_timeline_events_v1(const RoomID& room_id, const std::string& since_token);
+    nlohmann::json build_timeline_events_v1(const RoomID& room_id, const core::StreamToken& since);
     nlohmann::json build_state_events_v1(const RoomID& room_id);
     nlohmann::json build_ephemeral_events_v1(const RoomID& room_id, const UserID& user_id);
     nlohmann::json build_account_data_v1(const UserID& user_id);
@@ -3,6 +3,7 @@
 #include "../../common/api_types.hpp"
 #include "../../common/response_builder.hpp"
 #include "../../../core/event/event.hpp"
+#include "../../../core/event/event_schema.hpp"
 #include "../../../core/room/room.hpp"
 #include "../../../core/user/user.hpp"
 #include <memory>
@@ -52,6 +53,7 @@ private:
     bool can_user_ban_from_room(const RoomID& room_id, const UserID& banner, const UserID& bannee);
     bool can_user_leave_room(const RoomID& room_id, const UserID& user_id);
     std::shared_ptr<core::Event> create_message_event_from_request(const ApiRequest& request, const RoomID& room_id, const UserID& sender);
+    bool read_message_content(const ApiRequest& request, const std::string& event_type, Content& content);
     std::shared_ptr<core::Event> create_state_event_from_request(const ApiRequest& request, const RoomID& room_id, const UserID& sender);
     bool validate_event_for_room(const std::shared_ptr<core::Event>& event, const RoomID& room_id, const UserID& sender);
     std::string generate_transaction_id();
@@ -66,7 +68,6 @@ private:
     bool validate_state_event_content(const std::string& event_type, const nlohmann::json& content);
     nlohmann::json build_public_rooms_response(int limit, const std::string& since_token,
                                               const std::string& filter, const UserID& user_id);
-    bool should_include_room_in_public_list(const std::shared_ptr<core::Room>& room, const std::string& filter);
     bool validate_room_alias(const std::string& alias);
     std::string extract_localpart_from_alias(const std::string& alias);
     std::string generate_room_alias(const std::string& localpart, const std::string& server_name);
@@ -78,6 +79,7 @@ private:
     std::shared_ptr<core::RoomManager> room_manager_;
     std::shared_ptr<core::UserManager> user_manager_;
     std::shared_ptr<core::StateManager> state_manager_;
+    std::shared_ptr<const core::CompiledEventValidator> event_validator_;
     std::unordered_map<std::string, std::string> room_aliases_;
     std::unordered_map<std::string, std::vector<std::string>> alias_to_rooms_;
     std::unordered_map<UserID, std::unordered_map<std::string, int>> user_transaction_ids_;
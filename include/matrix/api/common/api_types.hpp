@@ -13,6 +13,7 @@ struct ApiRequest {
     std::string path;
     nlohmann::json query_params;
     nlohmann::json body;
+    std::string raw_body;
     std::unordered_map<std::string, std::string> headers;
     std::string access_token;
     UserID user_id;
@@ -23,6 +24,7 @@ struct ApiRequest {
 struct ApiResponse {
     int status_code = 200;
     nlohmann::json body;
+    std::optional<std::string> serialized_body;
     std::unordered_map<std::string, std::string> headers;
     std::string content_type = "application/json";
     std::string error;
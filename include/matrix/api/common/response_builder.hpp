@@ -2,6 +2,7 @@
 
 #include "api_types.hpp"
 #include "error_codes.hpp"
+#include "../../core/event/event.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -53,6 +54,10 @@ public:
 
     static ApiResponse sync_response(const nlohmann::json& sync_data);
     static ApiResponse event_response(const nlohmann::json& event_data);
+    static ApiResponse event_response(const core::Event& event);
+    static ApiResponse events_response(const std::vector<std::shared_ptr<core::Event>>& events, const std::string& key = "chunk");
+    static ApiResponse raw_json_response(std::string serialized_body, int status_code = 200);
+    static std::string serialize_body(const ApiResponse& response);
     static ApiResponse state_response(const nlohmann::json& state_data);
     static ApiResponse profile_response(const nlohmann::json& profile_data);
     static ApiResponse presence_response(const nlohmann::json& presence_data);
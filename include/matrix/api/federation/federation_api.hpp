@@ -4,6 +4,7 @@
 #include "../common/response_builder.hpp"
 #include "../../core/event/event.hpp"
 #include "../../core/room/room.hpp"
+#include "../../core/event/canonical_json.hpp"
 #include <memory>
 #include <unordered_map>
 
@@ -64,9 +65,12 @@ private:
     bool validate_event_for_federation(const std::shared_ptr<core::Event>& event, const std::string& origin_server);
     bool verify_event_signature(const std::shared_ptr<core::Event>& event, const std::string& origin_server);
     std::string sign_event(const std::shared_ptr<core::Event>& event);
+    crypto::CryptoResult<crypto::HashResult> compute_content_hash(const core::Event& event);
+    crypto::CryptoResult<crypto::HashResult> compute_reference_hash(const core::Event& event);
     nlohmann::json build_event_response(const EventID& event_id);
     nlohmann::json build_events_response(const std::vector<EventID>& event_ids);
     std::vector<std::shared_ptr<core::Event>> get_events_for_backfill(const RoomID& room_id, const std::vector<EventID>& event_ids, int limit);
+    std::shared_ptr<core::EventGraph> load_room_graph(const RoomID& room_id);
     nlohmann::json build_backfill_response(const RoomID& room_id, const std::vector<EventID>& event_ids, int limit);
     bool validate_user_keys_query(const std::string& server_name, const std::vector<UserID>& user_ids);
     nlohmann::json build_user_devices_response(const UserID& user_id);
@@ -74,6 +78,7 @@ private:
     nlohmann::json build_claimed_keys_response(const std::unordered_map<UserID, std::unordered_map<DeviceID, std::string>>& claims);
     bool validate_transaction(const nlohmann::json& transaction, const std::string& origin_server);
     bool process_transaction_events(const nlohmann::json& transaction, const std::string& origin_server);
+    bool process_raw_transaction(std::string_view body, const std::string& origin_server);
     nlohmann::json build_transaction_response(const std::string& transaction_id);
     nlohmann::json build_federated_public_rooms_response(int limit, const std::string& since_token, const std::string& server_name);
     bool should_federate_room_publicly(const std::shared_ptr<core::Room>& room);
@@ -81,6 +86,7 @@ private:
     nlohmann::json build_directory_response(const std::string& room_alias);
     nlohmann::json build_space_hierarchy_response(const RoomID& space_id, const std::string& suggested_only, int max_depth);
     nlohmann::json build_space_children_response(const RoomID& space_id);
+    nlohmann::json build_hierarchy_room(const core::RoomSummary& summary, const std::vector<nlohmann::json>& children_state);
     ApiResponse build_federation_error(const std::string& error_code, const std::string& message, const std::string& server_name = "");
     ApiResponse build_signature_verification_error(const std::string& server_name);
     ApiResponse build_room_not_found_error(const RoomID& room_id);
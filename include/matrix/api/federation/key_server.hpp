@@ -44,6 +44,7 @@ private:
     nlohmann::json get_device_keys(const UserID& user_id, const DeviceID& device_id = "");
     nlohmann::json get_one_time_keys(const UserID& user_id, const DeviceID& device_id = "");
     nlohmann::json claim_one_time_keys(const UserID& user_id, const std::unordered_map<DeviceID, std::string>& claims);
+    bool read_upload_keys_body(std::string_view body, nlohmann::json& device_keys, nlohmann::json& one_time_keys);
     bool validate_device_keys(const nlohmann::json& keys);
     bool validate_one_time_keys(const nlohmann::json& keys);
     bool verify_key_signatures(const nlohmann::json& keys, const nlohmann::json& signatures);
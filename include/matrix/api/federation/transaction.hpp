@@ -2,6 +2,9 @@
 
 #include "../common/api_types.hpp"
 #include "../../core/event/event.hpp"
+#include "../../core/event/canonical_json.hpp"
+#include "../../core/event/event_parser.hpp"
+#include "../../core/event/event_schema.hpp"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -34,6 +37,8 @@ public:
 
     nlohmann::json to_json() const;
     void from_json(const nlohmann::json& j);
+    bool from_raw(std::string_view body);
+    void write_json(std::string& out) const;
 
     bool validate() const;
     bool process();
@@ -107,6 +112,7 @@ public:
         bool success;
         std::vector<std::string> processed_events;
         std::vector<std::string> failed_events;
+        std::vector<core::ParseError> parse_errors;
         std::string error;
     };
 
@@ -124,6 +130,7 @@ private:
     bool process_signature_edu(const nlohmann::json& edu, const std::string& origin_server);
     bool validate_federation_event(const std::shared_ptr<core::Event>& event, const std::string& origin_server);
     bool verify_event_signature(const std::shared_ptr<core::Event>& event, const std::string& origin_server);
+    bool verify_content_hash(const core::Event& event);
     bool check_event_authorization(const std::shared_ptr<core::Event>& event, const std::string& origin_server);
     std::vector<std::shared_ptr<core::Event>> resolve_conflicting_events(const std::vector<std::shared_ptr<core::Event>>& events);
     bool apply_state_events(const RoomID& room_id, const std::vector<std::shared_ptr<core::Event>>& state_events);
@@ -132,6 +139,7 @@ private:
     std::shared_ptr<core::UserManager> user_manager_;
     std::shared_ptr<core::StateManager> state_manager_;
 
+    std::shared_ptr<const core::CompiledEventValidator> event_validator_;
     std::unordered_map<std::string, int> server_processing_limits_;
     std::unordered_map<std::string, Timestamp> last_processing_time_;
 };
@@ -58,10 +58,10 @@ private:
     void add_presence_subscription(const UserID& user_id, const UserID& target_user_id);
     void remove_presence_subscription(const UserID& user_id, const UserID& target_user_id);
     void cleanup_user_subscriptions(const UserID& user_id);
-    bool should_send_event_to_user(const std::shared_ptr<core::Event>& event, const UserID& user_id);
+    bool should_send_event_to_user(const core::Event& event, const UserID& user_id);
     bool should_send_presence_to_user(const UserID& target_user_id, const UserID& subscriber_id);
     bool should_send_typing_to_user(const RoomID& room_id, const UserID& user_id);
-    nlohmann::json filter_event_for_user(const std::shared_ptr<core::Event>& event, const UserID& user_id);
+    nlohmann::json filter_event_for_user(const core::Event& event, const UserID& user_id);
     nlohmann::json build_room_event_message(const std::shared_ptr<core::Event>& event);
     nlohmann::json build_presence_message(const UserID& user_id, const nlohmann::json& presence);
     nlohmann::json build_typing_message(const RoomID& room_id, const std::vector<UserID>& typing_users);
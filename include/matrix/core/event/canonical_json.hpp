@@ -0,0 +1,62 @@
+#pragma once
+
+#include "event.hpp"
+#include "room_event.hpp"
+#include "../../crypto/common/hash.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace matrix {
+
+// Writes the Matrix canonical JSON form (sorted keys, no insignificant
+// whitespace, minimal escaping, integers only) straight from Event fields into
+// a reusable buffer. When bound to a StreamingHash the buffer is flushed into
+// the hash as it fills, so no full intermediate string is built. The buffer
+// and hash binding are per-call state, so an instance must not be shared
+// between threads; use for_current_thread() and clear() it before use.
+class CanonicalJsonWriter {
+public:
+    enum class Form {
+        FULL,
+        CONTENT_HASH,
+        REDACTED,
+        REFERENCE_HASH
+    };
+
+    explicit CanonicalJsonWriter(size_t flush_threshold = 4096);
+    ~CanonicalJsonWriter() = default;
+
+    static CanonicalJsonWriter& for_current_thread();
+
+    void write_event(const Event& event, Form form);
+    void write_event(const Event& event, Form form, crypto::StreamingHash& hash);
+    void write_value(const nlohmann::json& value);
+
+    std::string_view view() const { return buffer_; }
+    std::string take() { return std::move(buffer_); }
+    void clear();
+
+    static std::string encode(const nlohmann::json& value);
+    static std::string encode(const Event& event, Form form);
+
+private:
+    std::string buffer_;
+    size_t flush_threshold_;
+    crypto::StreamingHash* hash_ = nullptr;
+
+    void write_raw(std::string_view text);
+    void write_string(std::string_view text);
+    void write_integer(int64_t value);
+    void write_key(std::string_view key, bool& first);
+    void write_object(const nlohmann::json& object, const std::vector<std::string_view>* keep_keys);
+    void write_event_ids(const std::vector<EventID>& ids);
+    void write_content(const Event& event, Form form);
+    void maybe_flush();
+    void flush();
+
+    static bool is_redacted_form(Form form);
+    static const std::vector<std::string_view>& preserved_content_keys(std::string_view event_type);
+};
+
+}
\ No newline at end of file
@@ -1,49 +1,86 @@
 #pragma once
 
 #include "../matrix_types.hpp"
+#include "lazy_content.hpp"
+#include "event_type.hpp"
+#include "../ref_counted.hpp"
 #include <string>
 #include <memory>
+#include <string_view>
 
 namespace matrix {
 
-    class Event {
+    class EventArena;
+
+    class Event : public RefCounted {
     public:
         Event() = default;
         virtual ~Event() = default;
 
-        EventID event_id() const { return event_id_; }
-        RoomID room_id() const { return room_id_; }
-        UserID sender() const { return sender_; }
-        std::string type() const { return type_; }
+        const EventID& event_id() const { return event_id_; }
+        const RoomID& room_id() const { return room_id_; }
+        const UserID& sender() const { return sender_; }
+        const std::string& type() const { return type_; }
+        EventType event_type() const { return event_type_; }
         int64_t origin_server_ts() const { return origin_server_ts_; }
-        UnsignedData unsigned_data() const { return unsigned_data_; }
-        Content content() const { return content_; }
+        const UnsignedData& unsigned_data() const { return unsigned_data_; }
+        const Content& content() const { return content_.get(); }
+        const LazyContent& lazy_content() const { return content_; }
+        std::string_view raw_content() const { return content_.raw(); }
+        bool has_raw_content() const { return content_.has_raw(); }
+
+        UnsignedData& mutable_unsigned_data() { return unsigned_data_; }
+        Content& mutable_content() { return content_.mutate(); }
 
         void set_event_id(const EventID& id) { event_id_ = id; }
         void set_room_id(const RoomID& id) { room_id_ = id; }
         void set_sender(const UserID& sender) { sender_ = sender; }
-        void set_type(const std::string& type) { type_ = type; }
+        void set_type(const std::string& type) {
+            type_ = type;
+            event_type_ = event_type_from_string(type_);
+        }
         void set_origin_server_ts(int64_t ts) { origin_server_ts_ = ts; }
         void set_unsigned_data(const UnsignedData& data) { unsigned_data_ = data; }
-        void set_content(const Content& content) { content_ = content; }
+        void set_content(const Content& content) { content_ = LazyContent(content); }
+        void set_content(Content&& content) { content_ = LazyContent(std::move(content)); }
+        void set_raw_content(std::string raw) { content_ = LazyContent::from_raw(std::move(raw)); }
 
         virtual nlohmann::json to_json() const;
         virtual void from_json(const nlohmann::json& j);
+        virtual void write_json(std::string& out) const;
 
         bool has_room_id() const { return !room_id_.empty(); }
         bool has_event_id() const { return !event_id_.empty(); }
         bool has_sender() const { return !sender_.empty(); }
 
+        bool is_state_type() const { return is_state_event_type(event_type_); }
+        bool is_power_type() const { return is_power_event_type(event_type_); }
+
+        EventArena* arena() const { return arena_; }
+
     protected:
         EventID event_id_;
         RoomID room_id_;
         UserID sender_;
-        std::string type_;
         int64_t origin_server_ts_ = 0;
         UnsignedData unsigned_data_;
-        Content content_;
+        LazyContent content_;
+
+    private:
+        friend class EventArena;
+
+        // Private so every write goes through set_type() and the two stay in
+        // step; from_json() and subclasses use set_type() as well.
+        std::string type_;
+        EventType event_type_ = EventType::UNKNOWN;
+
+        EventArena* arena_ = nullptr;
+        uint8_t arena_slot_class_ = 0;
     };
 
     using EventPtr = std::shared_ptr<Event>;
+    using EventRef = IntrusivePtr<Event>;
+
+    void intrusive_destroy(const Event* event);
 
 }
\ No newline at end of file
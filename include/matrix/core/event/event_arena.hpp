@@ -0,0 +1,112 @@
+#pragma once
+
+#include "event.hpp"
+#include "../ref_counted.hpp"
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace matrix {
+
+struct EventArenaConfig {
+    size_t chunk_size = 256 * 1024;
+    size_t max_chunks = 0;
+};
+
+// Per-room or per-batch event storage. Event objects live in fixed-size slab
+// slots carved out of large chunks, and the arena doubles as a pmr resource for
+// anything else that should share the events' lifetime. Every live event holds
+// a reference on its arena, so the chunks go away with the last event. Since
+// the last release deletes the arena, arenas only exist on the heap, through
+// create().
+class EventArena : public std::pmr::memory_resource, public RefCounted {
+public:
+    using ArenaConfig = EventArenaConfig;
+
+    struct ArenaStats {
+        size_t chunks;
+        size_t bytes_reserved;
+        size_t bytes_in_use;
+        size_t live_events;
+        size_t recycled_slots;
+    };
+
+    static IntrusivePtr<EventArena> create(const ArenaConfig& config = ArenaConfig()) {
+        return IntrusivePtr<EventArena>(new EventArena(config));
+    }
+
+    ~EventArena() override;
+
+    EventArena(const EventArena&) = delete;
+    EventArena& operator=(const EventArena&) = delete;
+
+    template<typename T, typename... Args>
+    IntrusivePtr<T> make_event(Args&&... args) {
+        static_assert(std::is_base_of_v<Event, T>, "arena only stores events");
+        static_assert(sizeof(T) <= SLOT_GRANULARITY * SIZE_CLASSES, "event type too large for slab");
+        static_assert(alignof(T) <= SLOT_ALIGNMENT, "event type over-aligned for slab");
+        const uint8_t slot_class = size_class(sizeof(T));
+        void* slot = allocate_slot(slot_class);
+        T* event = nullptr;
+        try {
+            event = new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            free_slot(slot, slot_class);
+            throw;
+        }
+        event->arena_ = this;
+        event->arena_slot_class_ = slot_class;
+        add_ref();
+        return IntrusivePtr<T>(event);
+    }
+
+    void destroy(const Event* event);
+
+    ArenaStats get_stats() const;
+
+private:
+    explicit EventArena(const ArenaConfig& config);
+
+    static constexpr size_t SLOT_ALIGNMENT = alignof(std::max_align_t);
+    static constexpr size_t SLOT_GRANULARITY = 64;
+    static constexpr size_t SIZE_CLASSES = 8;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    ArenaConfig config_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte* cursor_ = nullptr;
+    std::byte* chunk_end_ = nullptr;
+    std::array<FreeSlot*, SIZE_CLASSES> free_slots_{};
+    size_t bytes_in_use_ = 0;
+    size_t live_events_ = 0;
+    size_t recycled_slots_ = 0;
+
+    static constexpr uint8_t size_class(size_t size) {
+        return static_cast<uint8_t>((size + SLOT_GRANULARITY - 1) / SLOT_GRANULARITY - 1);
+    }
+
+    void* allocate_slot(uint8_t slot_class);
+    void free_slot(void* slot, uint8_t slot_class);
+    void* bump(size_t bytes, size_t alignment);
+    void add_chunk(size_t min_bytes);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+using EventArenaPtr = IntrusivePtr<EventArena>;
+
+inline void intrusive_destroy(const EventArena* arena) {
+    delete arena;
+}
+
+}
\ No newline at end of file
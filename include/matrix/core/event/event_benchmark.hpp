@@ -0,0 +1,68 @@
+#pragma once
+
+#include "event.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace matrix {
+
+// Fed by the global operator new replacement linked into the benchmark binary.
+class AllocationCounter {
+public:
+    static void record(size_t bytes) {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void reset() {
+        allocations_.store(0, std::memory_order_relaxed);
+        bytes_.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t allocations() { return allocations_.load(std::memory_order_relaxed); }
+    static size_t bytes() { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<size_t> allocations_{0};
+    static inline std::atomic<size_t> bytes_{0};
+};
+
+class EventBenchmark {
+public:
+    struct BenchmarkResult {
+        std::string name;
+        size_t event_count;
+        int64_t time_ns;
+        double allocations_per_event;
+        double bytes_per_event;
+        int64_t allocator_time_ns;
+        int64_t rss_bytes;
+        int iterations;
+    };
+
+    EventBenchmark();
+    ~EventBenchmark();
+
+    // Sync filter check (type, sender, room, content.url) reading through the
+    // old by-value getters versus the reference accessors.
+    BenchmarkResult benchmark_sync_filter_copying(size_t event_count = 10000, int iterations = 100);
+    BenchmarkResult benchmark_sync_filter_zero_copy(size_t event_count = 10000, int iterations = 100);
+
+    // Fills a single room timeline with shared_ptr events versus slab events
+    // from one EventArena; reports RSS growth and time spent allocating/freeing.
+    BenchmarkResult benchmark_room_shared_ptr(size_t event_count = 1000000);
+    BenchmarkResult benchmark_room_arena(size_t event_count = 1000000);
+
+    std::vector<BenchmarkResult> benchmark_all(size_t event_count = 10000, int iterations = 100);
+
+    nlohmann::json get_benchmark_results() const;
+
+private:
+    std::vector<BenchmarkResult> results_;
+
+    std::vector<EventPtr> generate_test_events(size_t count) const;
+    static int64_t current_rss_bytes();
+};
+
+}
\ No newline at end of file
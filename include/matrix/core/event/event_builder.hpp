@@ -4,6 +4,7 @@
 #include "room_event.hpp"
 #include "state_event.hpp"
 #include "message_event.hpp"
+#include "event_arena.hpp"
 #include <memory>
 
 namespace matrix {
@@ -32,12 +33,19 @@ public:
     static std::shared_ptr<VideoMessageEvent> create_video_message_event(const RoomID& room_id, const UserID& sender, const std::string& url, const Content& info);
 
     static EventPtr from_json(const nlohmann::json& data);
+
+    static EventRef create_event(EventArena& arena, const std::string& type);
+    static EventRef create_event(EventArena& arena, const nlohmann::json& data);
+    static IntrusivePtr<TextMessageEvent> create_text_message_event(EventArena& arena, const RoomID& room_id, const UserID& sender, const std::string& body);
+    static IntrusivePtr<RoomMemberEvent> create_room_member_event(EventArena& arena, const RoomID& room_id, const UserID& sender, const UserID& target, Membership membership);
+    static EventRef from_json(EventArena& arena, const nlohmann::json& data);
+
     static std::string generate_event_id();
     static int64_t current_timestamp();
 
 private:
     static std::string generate_random_string(size_t length);
-    static EventType parse_event_type(const std::string& type_str);
+    static EventType parse_event_type(std::string_view type_str) { return event_type_from_string(type_str); }
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "event.hpp"
+#include "event_arena.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace matrix {
+
+// Versioned binary form of an event for caches and the events.encoded column.
+//
+//   u8  magic 'E'      u8 version      u8 kind (Event/RoomEvent/State/Message)
+//   varint field mask  (which optional fields follow)
+//   type      : varint (EventType id + 1), or 0 followed by an inline string
+//   ids       : varint length + bytes (event_id, room_id, sender, state_key)
+//   ts/depth  : zigzag varints
+//   edges     : varint count + ids (prev_events, auth_events)
+//   content   : varint length + canonical JSON bytes
+//   unsigned, hashes, signatures : as content
+//
+// Object bodies are written through CanonicalJsonWriter, including raw
+// LazyContent bytes, which are reparsed and rewritten rather than copied as
+// received. decode(encode(e)) therefore reproduces the exact canonical JSON
+// of e and signatures computed over it remain valid.
+class BinaryEventCodec {
+public:
+    static constexpr uint8_t MAGIC = 'E';
+    static constexpr uint8_t FORMAT_VERSION = 1;
+
+    enum class Kind : uint8_t {
+        EVENT,
+        ROOM_EVENT,
+        STATE_EVENT,
+        MESSAGE_EVENT
+    };
+
+    static std::vector<uint8_t> encode(const Event& event);
+    static void encode_into(const Event& event, std::vector<uint8_t>& out);
+
+    static EventPtr decode(const uint8_t* data, size_t size);
+    static EventPtr decode(const std::vector<uint8_t>& data) { return decode(data.data(), data.size()); }
+    static EventRef decode(EventArena& arena, const uint8_t* data, size_t size);
+
+    static bool to_canonical_json(const uint8_t* data, size_t size, std::string& out);
+    static std::optional<uint8_t> peek_version(const uint8_t* data, size_t size);
+    static size_t encoded_size(const Event& event);
+
+    static void write_varint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static bool read_varint(const uint8_t*& data, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && data < end; shift += 7) {
+            const uint8_t byte = *data++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static uint64_t zigzag_encode(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    static int64_t zigzag_decode(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+private:
+    enum FieldMask : uint32_t {
+        HAS_EVENT_ID = 1u << 0,
+        HAS_ROOM_ID = 1u << 1,
+        HAS_STATE_KEY = 1u << 2,
+        HAS_UNSIGNED = 1u << 3,
+        HAS_PREV_EVENTS = 1u << 4,
+        HAS_AUTH_EVENTS = 1u << 5,
+        HAS_DEPTH = 1u << 6,
+        HAS_HASHES = 1u << 7,
+        HAS_SIGNATURES = 1u << 8,
+        HAS_REDACTS = 1u << 9,
+        HAS_ORIGIN = 1u << 10
+    };
+
+    static void write_string(std::vector<uint8_t>& out, std::string_view value);
+    // Length-prefixed canonical JSON of content; never the raw bytes as-is.
+    static void write_content(std::vector<uint8_t>& out, const LazyContent& content);
+    static bool read_string(const uint8_t*& data, const uint8_t* end, std::string& value);
+    static bool decode_into(const uint8_t* data, size_t size, Event& event);
+    static Kind kind_of(const Event& event);
+};
+
+}
\ No newline at end of file
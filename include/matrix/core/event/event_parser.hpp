@@ -1,11 +1,48 @@
 #pragma once
 
 #include "event.hpp"
+#include "event_arena.hpp"
+#include "event_reader.hpp"
+#include "../worker_pool.hpp"
 #include <memory>
 #include <functional>
 
 namespace matrix {
 
+enum class ParseErrorCode : uint8_t {
+    NONE,
+    INVALID_JSON,
+    NOT_AN_OBJECT,
+    MISSING_FIELD,
+    WRONG_TYPE,
+    INVALID_IDENTIFIER,
+    TOO_LARGE,
+    UNKNOWN_EVENT_TYPE
+};
+
+enum class EventField : uint8_t {
+    NONE,
+    EVENT_ID,
+    ROOM_ID,
+    SENDER,
+    TYPE,
+    STATE_KEY,
+    CONTENT,
+    ORIGIN_SERVER_TS,
+    UNSIGNED,
+    PREV_EVENTS,
+    AUTH_EVENTS,
+    DEPTH,
+    HASHES,
+    SIGNATURES
+};
+
+struct ParseError {
+    uint32_t index = 0;
+    ParseErrorCode code = ParseErrorCode::NONE;
+    EventField field = EventField::NONE;
+};
+
 class EventParser {
 public:
     EventParser() = default;
@@ -13,10 +50,30 @@ public:
 
     static EventPtr parse(const nlohmann::json& data);
     static EventPtr parse(const std::string& json_string);
+    static EventPtr parse_lazy(std::string_view json_string);
+    static EventPtr parse_with_raw_content(const nlohmann::json& fields, std::string raw_content);
+
+    static EventRef parse(EventArena& arena, const nlohmann::json& data);
+    static EventRef parse_lazy(EventArena& arena, std::string_view json_string);
+
+    struct BatchResult {
+        std::vector<EventPtr> events;
+        std::vector<ParseError> errors;
+
+        bool all_ok() const { return errors.empty(); }
+    };
+
+    // Results keep input order; events[i] is null when raw_events[i] failed and
+    // errors holds one entry per failure, sorted by index.
+    static BatchResult parse_batch(const std::vector<std::string_view>& raw_events, WorkerPool& pool = WorkerPool::shared());
+    static BatchResult parse_batch(const std::vector<nlohmann::json>& events, WorkerPool& pool = WorkerPool::shared());
 
     static bool validate_event(const nlohmann::json& data);
     static bool validate_event(const EventPtr& event);
 
+    static const char* describe(ParseErrorCode code);
+    static const char* describe(EventField field);
+
     static std::string extract_event_type(const nlohmann::json& data);
     static std::string extract_room_id(const nlohmann::json& data);
     static std::string extract_sender(const nlohmann::json& data);
@@ -26,7 +83,7 @@ public:
     static bool is_message_event(const nlohmann::json& data);
     static bool is_room_event(const nlohmann::json& data);
 
-    static EventType classify_event_type(const std::string& event_type);
+    static EventType classify_event_type(std::string_view event_type) { return event_type_from_string(event_type); }
 
     void set_strict_validation(bool strict) { strict_validation_ = strict; }
     bool strict_validation() const { return strict_validation_; }
@@ -39,17 +96,26 @@ public:
         static bool validate_event_structure(const nlohmann::json& data);
 
         static std::vector<std::string> get_validation_errors(const nlohmann::json& data);
+
+        static ParseError check_event_structure(const nlohmann::json& data);
+        static std::vector<ParseError> validate_batch(const std::vector<nlohmann::json>& events, WorkerPool& pool = WorkerPool::shared());
+        static std::vector<ParseError> validate_batch(const std::vector<EventPtr>& events, WorkerPool& pool = WorkerPool::shared());
     };
 
 private:
     bool strict_validation_ = true;
 
+    static constexpr size_t MIN_BATCH_CHUNK = 8;
+
     static EventPtr parse_room_event(const nlohmann::json& data);
     static EventPtr parse_state_event(const nlohmann::json& data);
     static EventPtr parse_message_event(const nlohmann::json& data);
     static EventPtr parse_basic_event(const nlohmann::json& data);
 
+    static EventRef parse_into(EventArena& arena, const nlohmann::json& data);
+
     static void populate_common_fields(Event& event, const nlohmann::json& data);
+    static bool split_raw_content(std::string_view json_string, nlohmann::json& fields, std::string& raw_content);
     static void populate_room_event_fields(RoomEvent& event, const nlohmann::json& data);
 };
 
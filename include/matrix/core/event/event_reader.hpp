@@ -0,0 +1,62 @@
+#pragma once
+
+#include "event.hpp"
+#include "event_arena.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace matrix {
+
+// Single-pass reader that validates raw event JSON and writes the fields
+// straight into Event objects without building an intermediate nlohmann DOM.
+// Uses simdjson on-demand when built with MATRIX_HAVE_SIMDJSON and falls back
+// to a scalar SAX reader otherwise. Parser buffers are reused between calls,
+// so an instance must not be shared between threads; use for_current_thread().
+class EventReader {
+public:
+    enum class Backend {
+        AUTO,
+        SIMD,
+        SCALAR
+    };
+
+    struct TransactionView {
+        std::string origin;
+        int64_t origin_server_ts = 0;
+        std::vector<std::string_view> pdus;
+        std::vector<std::string_view> edus;
+    };
+
+    explicit EventReader(Backend backend = Backend::AUTO);
+    ~EventReader();
+
+    EventReader(const EventReader&) = delete;
+    EventReader& operator=(const EventReader&) = delete;
+
+    static EventReader& for_current_thread();
+    static bool simd_available();
+
+    Backend backend() const { return backend_; }
+
+    EventPtr read_event(std::string_view json);
+    EventRef read_event(EventArena& arena, std::string_view json);
+    bool read_event_into(std::string_view json, Event& event);
+
+    bool read_content(std::string_view json, const std::string& event_type, Content& content);
+    bool read_transaction(std::string_view json, TransactionView& transaction);
+    bool read_document(std::string_view json, nlohmann::json& document);
+    bool validate(std::string_view json);
+
+    const std::string& last_error() const { return last_error_; }
+
+private:
+    class Impl;
+
+    Backend backend_;
+    std::unique_ptr<Impl> impl_;
+    std::string last_error_;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "event.hpp"
+#include "event_parser.hpp"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace matrix {
+
+enum class JsonKind : uint8_t {
+    ANY,
+    STRING,
+    INTEGER,
+    BOOLEAN,
+    OBJECT,
+    ARRAY
+};
+
+struct SchemaLimits {
+    size_t max_message_length = 65536;
+    size_t max_event_size = 65536;
+    size_t max_identifier_length = 255;
+    size_t max_state_key_length = 255;
+    size_t max_edges = 20;
+
+    static SchemaLimits from_config(const nlohmann::json& config);
+};
+
+struct FieldRule {
+    std::string key;
+    JsonKind kind = JsonKind::ANY;
+    bool required = false;
+    size_t max_length = 0;
+    EventField field = EventField::NONE;
+};
+
+struct EventSchema {
+    std::string event_type;
+    bool state_event = false;
+    std::vector<FieldRule> fields;
+    std::vector<FieldRule> content;
+};
+
+// Flat rule table produced by EventSchemaCompiler. check() walks the event's
+// top-level keys and its content keys once each, ticking a per-rule bit, then
+// compares the seen mask against the required mask; nothing is allocated
+// unless an error has to be returned to a caller that wants messages.
+class CompiledEventValidator {
+public:
+    static constexpr size_t MAX_RULES_PER_TYPE = 64;
+
+    ParseError check(const nlohmann::json& event) const;
+    ParseError check(const Event& event) const;
+    bool is_valid(const nlohmann::json& event) const { return check(event).code == ParseErrorCode::NONE; }
+
+    const SchemaLimits& limits() const { return limits_; }
+
+private:
+    friend class EventSchemaCompiler;
+
+    struct Rule {
+        uint16_t key_offset;
+        uint16_t key_length;
+        JsonKind kind;
+        bool in_content;
+        EventField field;
+        uint32_t max_length;
+    };
+
+    struct RuleRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint64_t required_fields = 0;
+        uint64_t required_content = 0;
+        bool state_event = false;
+    };
+
+    SchemaLimits limits_;
+    std::string key_pool_;
+    std::vector<Rule> rules_;
+    std::array<RuleRange, static_cast<size_t>(EventType::UNKNOWN) + 1> ranges_{};
+
+    const RuleRange& range_for(EventType type) const { return ranges_[static_cast<size_t>(type)]; }
+    int find_rule(const RuleRange& range, std::string_view key, bool in_content) const;
+    static bool matches_kind(const nlohmann::json& value, JsonKind kind);
+};
+
+class EventSchemaCompiler {
+public:
+    explicit EventSchemaCompiler(const SchemaLimits& limits = SchemaLimits());
+
+    EventSchemaCompiler& add_schema(const EventSchema& schema);
+    EventSchemaCompiler& add_builtin_schemas();
+
+    std::shared_ptr<const CompiledEventValidator> compile() const;
+
+    static std::shared_ptr<const CompiledEventValidator> default_validator();
+    static void set_default_validator(std::shared_ptr<const CompiledEventValidator> validator);
+
+private:
+    SchemaLimits limits_;
+    std::vector<EventSchema> schemas_;
+
+    static EventSchema common_room_event_schema(const SchemaLimits& limits);
+};
+
+}
\ No newline at end of file
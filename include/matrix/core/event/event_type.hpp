@@ -0,0 +1,150 @@
+#pragma once
+
+#include "../types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace matrix {
+
+namespace detail {
+
+struct EventTypeName {
+    std::string_view name;
+    EventType type;
+};
+
+inline constexpr std::array<EventTypeName, 24> KNOWN_EVENT_TYPES = {{
+    {"m.room.create", EventType::ROOM_CREATE},
+    {"m.room.join_rules", EventType::ROOM_JOIN_RULES},
+    {"m.room.power_levels", EventType::ROOM_POWER_LEVELS},
+    {"m.room.member", EventType::ROOM_MEMBER},
+    {"m.room.message", EventType::ROOM_MESSAGE},
+    {"m.room.encryption", EventType::ROOM_ENCRYPTION},
+    {"m.room.redaction", EventType::ROOM_REDACTION},
+    {"m.room.history_visibility", EventType::ROOM_HISTORY_VISIBILITY},
+    {"m.room.guest_access", EventType::ROOM_GUEST_ACCESS},
+    {"m.room.aliases", EventType::ROOM_ALIASES},
+    {"m.room.canonical_alias", EventType::ROOM_CANONICAL_ALIAS},
+    {"m.room.name", EventType::ROOM_NAME},
+    {"m.room.topic", EventType::ROOM_TOPIC},
+    {"m.room.avatar", EventType::ROOM_AVATAR},
+    {"m.room.pinned_events", EventType::ROOM_PINNED_EVENTS},
+    {"m.room.tombstone", EventType::ROOM_TOMBSTONE},
+    {"m.room.server_acl", EventType::ROOM_SERVER_ACL},
+    {"m.typing", EventType::TYPING},
+    {"m.receipt", EventType::RECEIPT},
+    {"m.presence", EventType::PRESENCE},
+    {"m.fully_read", EventType::FULLY_READ},
+    {"m.tag", EventType::TAG},
+    {"m.direct", EventType::DIRECT},
+    {"m.ignored_user_list", EventType::IGNORED_USER_LIST},
+}};
+
+inline constexpr size_t EVENT_TYPE_TABLE_SIZE = 64;
+
+// Hashes only the length and three characters at fixed offsets, so a lookup
+// is a handful of loads plus one length-checked compare against the slot.
+constexpr uint32_t event_type_hash(std::string_view name, uint32_t seed) {
+    if (name.size() < 3) {
+        return static_cast<uint32_t>(name.size());
+    }
+    const auto at = [&](size_t i) { return static_cast<uint32_t>(static_cast<unsigned char>(name[i])); };
+    uint32_t h = static_cast<uint32_t>(name.size()) * 0x9E3779B1u;
+    h ^= (at(name.size() - 1) + (at(name.size() - 3) << 8) + (at(name.size() / 2) << 16)) * seed;
+    return (h ^ (h >> 15)) & static_cast<uint32_t>(EVENT_TYPE_TABLE_SIZE - 1);
+}
+
+constexpr bool is_perfect_seed(uint32_t seed) {
+    bool used[EVENT_TYPE_TABLE_SIZE] = {};
+    for (const auto& entry : KNOWN_EVENT_TYPES) {
+        const uint32_t slot = event_type_hash(entry.name, seed);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t find_perfect_seed() {
+    for (uint32_t seed = 1; seed < 100000; seed += 2) {
+        if (is_perfect_seed(seed)) {
+            return seed;
+        }
+    }
+    return 0;
+}
+
+inline constexpr uint32_t EVENT_TYPE_SEED = find_perfect_seed();
+static_assert(EVENT_TYPE_SEED != 0, "no collision-free seed for the known event types");
+
+constexpr std::array<int8_t, EVENT_TYPE_TABLE_SIZE> build_event_type_table() {
+    std::array<int8_t, EVENT_TYPE_TABLE_SIZE> table{};
+    for (auto& slot : table) {
+        slot = -1;
+    }
+    for (size_t i = 0; i < KNOWN_EVENT_TYPES.size(); ++i) {
+        table[event_type_hash(KNOWN_EVENT_TYPES[i].name, EVENT_TYPE_SEED)] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+inline constexpr std::array<int8_t, EVENT_TYPE_TABLE_SIZE> EVENT_TYPE_TABLE = build_event_type_table();
+
+}
+
+constexpr EventType event_type_from_string(std::string_view name) {
+    const int8_t index = detail::EVENT_TYPE_TABLE[detail::event_type_hash(name, detail::EVENT_TYPE_SEED)];
+    if (index < 0 || detail::KNOWN_EVENT_TYPES[index].name != name) {
+        return EventType::UNKNOWN;
+    }
+    return detail::KNOWN_EVENT_TYPES[index].type;
+}
+
+constexpr std::string_view event_type_to_string(EventType type) {
+    for (const auto& entry : detail::KNOWN_EVENT_TYPES) {
+        if (entry.type == type) {
+            return entry.name;
+        }
+    }
+    return {};
+}
+
+constexpr bool is_state_event_type(EventType type) {
+    switch (type) {
+    case EventType::ROOM_CREATE:
+    case EventType::ROOM_JOIN_RULES:
+    case EventType::ROOM_POWER_LEVELS:
+    case EventType::ROOM_MEMBER:
+    case EventType::ROOM_ENCRYPTION:
+    case EventType::ROOM_HISTORY_VISIBILITY:
+    case EventType::ROOM_GUEST_ACCESS:
+    case EventType::ROOM_ALIASES:
+    case EventType::ROOM_CANONICAL_ALIAS:
+    case EventType::ROOM_NAME:
+    case EventType::ROOM_TOPIC:
+    case EventType::ROOM_AVATAR:
+    case EventType::ROOM_PINNED_EVENTS:
+    case EventType::ROOM_TOMBSTONE:
+    case EventType::ROOM_SERVER_ACL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Power events per state resolution v2; a member event only counts when it
+// is a kick or ban, which needs the content and is checked by the caller.
+constexpr bool is_power_event_type(EventType type) {
+    return type == EventType::ROOM_CREATE ||
+           type == EventType::ROOM_POWER_LEVELS ||
+           type == EventType::ROOM_JOIN_RULES;
+}
+
+constexpr bool is_ephemeral_event_type(EventType type) {
+    return type == EventType::TYPING || type == EventType::RECEIPT || type == EventType::PRESENCE;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../matrix_types.hpp"
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace matrix {
+
+// Event content that keeps the serialized bytes it arrived with. The DOM is
+// only built when something asks for it; single fields can be read straight
+// from the bytes, and unmodified content is written back out verbatim.
+class LazyContent {
+public:
+    LazyContent() = default;
+    LazyContent(const Content& content);
+    LazyContent(Content&& content);
+    ~LazyContent();
+
+    LazyContent(const LazyContent& other);
+    LazyContent(LazyContent&& other) noexcept;
+    LazyContent& operator=(const LazyContent& other);
+    LazyContent& operator=(LazyContent&& other) noexcept;
+
+    static LazyContent from_raw(std::string raw);
+
+    bool has_raw() const { return !raw_.empty(); }
+    bool is_parsed() const { return parsed_.load(std::memory_order_acquire) != nullptr; }
+    std::string_view raw() const { return raw_; }
+
+    const Content& get() const;
+    Content& mutate();
+
+    bool contains(std::string_view key) const;
+    std::optional<std::string_view> find_raw_field(std::string_view key) const;
+    std::optional<std::string> get_string(std::string_view key) const;
+    std::optional<int64_t> get_int64(std::string_view key) const;
+    std::optional<bool> get_bool(std::string_view key) const;
+
+    void write_to(std::string& out) const;
+    size_t serialized_size() const;
+
+private:
+    std::string raw_;
+    mutable std::atomic<Content*> parsed_{nullptr};
+
+    const Content& parse() const;
+    void reset();
+
+    static const Content& empty();
+};
+
+}
\ No newline at end of file
@@ -9,7 +9,7 @@ public:
     MessageEvent() = default;
     MessageEvent(const RoomID& room_id, const UserID& sender, const std::string& msgtype);
 
-    std::string msgtype() const;
+    std::string_view msgtype() const;
     void set_msgtype(const std::string& msgtype);
 
     nlohmann::json to_json() const override;
@@ -24,13 +24,13 @@ public:
     TextMessageEvent() = default;
     TextMessageEvent(const RoomID& room_id, const UserID& sender, const std::string& body);
 
-    std::string body() const;
+    std::string_view body() const;
     void set_body(const std::string& body);
 
-    std::string formatted_body() const;
+    std::string_view formatted_body() const;
     void set_formatted_body(const std::string& formatted_body);
 
-    std::string format() const;
+    std::string_view format() const;
     void set_format(const std::string& format);
 
     nlohmann::json to_json() const override;
@@ -54,13 +54,13 @@ public:
     MediaMessageEvent() = default;
     MediaMessageEvent(const RoomID& room_id, const UserID& sender, const std::string& msgtype);
 
-    std::string url() const;
+    std::string_view url() const;
     void set_url(const std::string& url);
 
-    Content info() const;
+    const nlohmann::json& info() const;
     void set_info(const Content& info);
 
-    std::string filename() const;
+    std::string_view filename() const;
     void set_filename(const std::string& filename);
 
     nlohmann::json to_json() const override;
@@ -96,7 +96,7 @@ public:
     LocationMessageEvent() = default;
     LocationMessageEvent(const RoomID& room_id, const UserID& sender, const std::string& body, const Content& geo_uri);
 
-    Content geo_uri() const;
+    const nlohmann::json& geo_uri() const;
     void set_geo_uri(const Content& geo_uri);
 
     nlohmann::json to_json() const override;
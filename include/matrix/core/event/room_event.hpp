@@ -9,7 +9,7 @@ public:
     RoomEvent() = default;
     explicit RoomEvent(const RoomID& room_id) { room_id_ = room_id; }
 
-    std::string state_key() const { return state_key_; }
+    const std::string& state_key() const { return state_key_ ? *state_key_ : empty_state_key(); }
     void set_state_key(const std::string& state_key) { state_key_ = state_key; }
 
     nlohmann::json to_json() const override;
@@ -17,8 +17,36 @@ public:
 
     bool has_state_key() const { return state_key_.has_value(); }
 
+    const std::vector<EventID>& prev_events() const { return prev_events_; }
+    const std::vector<EventID>& auth_events() const { return auth_events_; }
+    int64_t depth() const { return depth_; }
+    const std::string& origin() const { return origin_; }
+    const std::string& redacts() const { return redacts_; }
+    const nlohmann::json& hashes() const { return hashes_; }
+    const nlohmann::json& signatures() const { return signatures_; }
+
+    void set_prev_events(std::vector<EventID> prev_events) { prev_events_ = std::move(prev_events); }
+    void set_auth_events(std::vector<EventID> auth_events) { auth_events_ = std::move(auth_events); }
+    void set_depth(int64_t depth) { depth_ = depth; }
+    void set_origin(const std::string& origin) { origin_ = origin; }
+    void set_redacts(const std::string& redacts) { redacts_ = redacts; }
+    void set_hashes(const nlohmann::json& hashes) { hashes_ = hashes; }
+    void set_signatures(const nlohmann::json& signatures) { signatures_ = signatures; }
+
 private:
     std::optional<std::string> state_key_;
+    std::vector<EventID> prev_events_;
+    std::vector<EventID> auth_events_;
+    int64_t depth_ = 0;
+    std::string origin_;
+    std::string redacts_;
+    nlohmann::json hashes_;
+    nlohmann::json signatures_;
+
+    static const std::string& empty_state_key() {
+        static const std::string empty;
+        return empty;
+    }
 };
 
 class RoomMessageEvent : public RoomEvent {
@@ -26,8 +54,8 @@ public:
     RoomMessageEvent() = default;
     RoomMessageEvent(const RoomID& room_id, const UserID& sender, const std::string& body);
 
-    std::string body() const;
-    std::string msgtype() const;
+    std::string_view body() const;
+    std::string_view msgtype() const;
     void set_body(const std::string& body);
     void set_msgtype(const std::string& msgtype);
 
@@ -43,10 +71,10 @@ public:
     RoomMemberEvent() = default;
     RoomMemberEvent(const RoomID& room_id, const UserID& sender, const UserID& target, Membership membership);
 
-    UserID target_user_id() const;
+    const UserID& target_user_id() const { return state_key(); }
     Membership membership() const;
-    std::string display_name() const;
-    std::string avatar_url() const;
+    std::string_view display_name() const;
+    std::string_view avatar_url() const;
 
     void set_membership(Membership membership);
     void set_display_name(const std::string& display_name);
@@ -20,8 +20,8 @@ public:
     RoomCreateEvent() = default;
     RoomCreateEvent(const RoomID& room_id, const UserID& creator);
 
-    UserID creator() const;
-    std::string room_version() const;
+    std::string_view creator() const;
+    std::string_view room_version() const;
     void set_creator(const UserID& creator);
     void set_room_version(const std::string& version);
 
@@ -55,7 +55,7 @@ public:
     RoomJoinRulesEvent() = default;
     RoomJoinRulesEvent(const RoomID& room_id, const std::string& join_rule);
 
-    std::string join_rule() const;
+    std::string_view join_rule() const;
     void set_join_rule(const std::string& join_rule);
 
     nlohmann::json to_json() const override;
@@ -70,7 +70,7 @@ public:
     RoomEncryptionEvent() = default;
     RoomEncryptionEvent(const RoomID& room_id, const std::string& algorithm);
 
-    std::string algorithm() const;
+    std::string_view algorithm() const;
     void set_algorithm(const std::string& algorithm);
 
     nlohmann::json to_json() const override;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace matrix {
+
+// TinyLFU popularity estimate: a count-min sketch of 4-bit counters packed
+// sixteen to a word, four hashed rows per key. After sample_size increments
+// every counter is halved so old popularity fades.
+class FrequencySketch {
+public:
+    explicit FrequencySketch(size_t capacity = 1024) { resize(capacity); }
+
+    void resize(size_t capacity) {
+        size_t words = 8;
+        while (words < capacity) {
+            words <<= 1;
+        }
+        table_.assign(words, 0);
+        mask_ = words - 1;
+        sample_size_ = capacity * 10;
+        additions_ = 0;
+    }
+
+    void increment(uint64_t hash) {
+        bool added = false;
+        for (unsigned row = 0; row < 4; ++row) {
+            added |= increment_at(index_of(hash, row), counter_of(hash, row));
+        }
+        if (added && ++additions_ >= sample_size_) {
+            age();
+        }
+    }
+
+    unsigned estimate(uint64_t hash) const {
+        unsigned frequency = 15;
+        for (unsigned row = 0; row < 4; ++row) {
+            const unsigned count = static_cast<unsigned>((table_[index_of(hash, row)] >> (counter_of(hash, row) << 2)) & 0xF);
+            frequency = count < frequency ? count : frequency;
+        }
+        return frequency;
+    }
+
+private:
+    std::vector<uint64_t> table_;
+    size_t mask_ = 0;
+    size_t sample_size_ = 0;
+    size_t additions_ = 0;
+
+    static uint64_t mix(uint64_t hash, unsigned row) {
+        hash += 0x9E3779B97F4A7C15ull * (row + 1);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        return hash ^ (hash >> 31);
+    }
+
+    size_t index_of(uint64_t hash, unsigned row) const { return static_cast<size_t>(mix(hash, row)) & mask_; }
+    static unsigned counter_of(uint64_t hash, unsigned row) { return static_cast<unsigned>(mix(hash, row) >> 60); }
+
+    bool increment_at(size_t index, unsigned counter) {
+        const unsigned shift = counter << 2;
+        if (((table_[index] >> shift) & 0xF) == 0xF) {
+            return false;
+        }
+        table_[index] += uint64_t(1) << shift;
+        return true;
+    }
+
+    void age() {
+        for (auto& word : table_) {
+            word = (word >> 1) & 0x7777777777777777ull;
+        }
+        additions_ /= 2;
+    }
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace matrix {
+
+// Compressed set of 32-bit interned handles in the Roaring layout: values are
+// grouped by their high 16 bits, and each group is a sorted uint16 array while
+// it has at most ARRAY_MAX_SIZE entries and a 65536-bit bitmap after that.
+// Interned handles are dense, so large rooms end up as a few bitmap containers
+// and intersections are word-wise ANDs.
+class HandleBitmap {
+public:
+    static constexpr size_t ARRAY_MAX_SIZE = 4096;
+    static constexpr size_t BITMAP_WORDS = 1024;
+
+    HandleBitmap() = default;
+
+    bool add(uint32_t value);
+    bool remove(uint32_t value);
+    bool contains(uint32_t value) const;
+
+    size_t cardinality() const;
+    bool empty() const { return containers_.empty(); }
+    void clear() { containers_.clear(); }
+
+    void for_each(const std::function<void(uint32_t)>& fn) const;
+    std::vector<uint32_t> to_vector() const;
+
+    HandleBitmap& operator&=(const HandleBitmap& other);
+    HandleBitmap& operator|=(const HandleBitmap& other);
+    HandleBitmap& operator-=(const HandleBitmap& other);
+
+    static HandleBitmap intersect(const HandleBitmap& a, const HandleBitmap& b);
+    static size_t intersection_cardinality(const HandleBitmap& a, const HandleBitmap& b);
+    static bool intersects(const HandleBitmap& a, const HandleBitmap& b);
+
+    size_t memory_usage() const;
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;
+        std::unique_ptr<uint64_t[]> bitmap;
+
+        Container() = default;
+        Container(const Container& other);
+        Container& operator=(const Container& other);
+        Container(Container&&) noexcept = default;
+        Container& operator=(Container&&) noexcept = default;
+
+        bool is_bitmap() const { return bitmap != nullptr; }
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        bool contains(uint16_t low) const;
+        void to_bitmap();
+        void to_array();
+    };
+
+    std::vector<Container> containers_;
+
+    Container* find_container(uint16_t key);
+    const Container* find_container(uint16_t key) const;
+    Container& get_or_create_container(uint16_t key);
+
+    static Container intersect(const Container& a, const Container& b);
+    static size_t intersection_cardinality(const Container& a, const Container& b);
+};
+
+}
\ No newline at end of file
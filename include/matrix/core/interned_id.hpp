@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace matrix {
+
+enum class IdKind : uint8_t {
+    USER,
+    ROOM,
+    EVENT,
+    DEVICE,
+    SERVER
+};
+
+// Append-only string table handing out dense 32-bit handles. Lookups and
+// resolves never take a lock; inserts race on a CAS and only the rare index
+// growth is serialized. Handle 0 is reserved for "no id".
+//
+// Nothing is ever evicted, so only ids of users, rooms and events the server
+// has accepted are interned. Ids from untrusted input (client cursors,
+// request paths, unverified federation PDUs) are looked up with find(); an
+// id that is not in the table cannot refer to anything we hold.
+class InternTable {
+public:
+    static constexpr uint32_t INVALID_HANDLE = 0;
+
+    InternTable();
+    ~InternTable();
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    uint32_t intern(std::string_view text);
+    uint32_t find(std::string_view text) const;
+    const std::string& resolve(uint32_t handle) const;
+
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+    size_t memory_usage() const;
+
+    template<IdKind Kind>
+    static InternTable& instance() {
+        static InternTable table;
+        return table;
+    }
+
+private:
+    static constexpr size_t SEGMENT_BITS = 16;
+    static constexpr size_t SEGMENT_SIZE = size_t{1} << SEGMENT_BITS;
+    static constexpr size_t MAX_SEGMENTS = size_t{1} << (32 - SEGMENT_BITS);
+
+    struct Index {
+        size_t capacity;
+        std::atomic<uint64_t>* slots;
+        Index* retired;
+    };
+
+    std::array<std::atomic<std::string*>, MAX_SEGMENTS> segments_;
+    std::atomic<Index*> index_;
+    std::atomic<uint32_t> count_{0};
+    std::mutex grow_mutex_;
+
+    uint32_t append(std::string_view text);
+    bool publish(Index* index, uint64_t hash, uint32_t handle);
+    void grow(Index* current);
+
+    static uint64_t hash(std::string_view text);
+};
+
+template<IdKind Kind>
+class InternedID {
+public:
+    constexpr InternedID() = default;
+    constexpr explicit InternedID(uint32_t handle) : handle_(handle) {}
+
+    static InternedID intern(std::string_view text) {
+        return InternedID(InternTable::instance<Kind>().intern(text));
+    }
+
+    static InternedID find(std::string_view text) {
+        return InternedID(InternTable::instance<Kind>().find(text));
+    }
+
+    const std::string& str() const { return InternTable::instance<Kind>().resolve(handle_); }
+    std::string_view view() const { return str(); }
+
+    constexpr uint32_t handle() const { return handle_; }
+    constexpr bool valid() const { return handle_ != InternTable::INVALID_HANDLE; }
+    constexpr explicit operator bool() const { return valid(); }
+
+    constexpr bool operator==(InternedID other) const { return handle_ == other.handle_; }
+    constexpr bool operator!=(InternedID other) const { return handle_ != other.handle_; }
+    constexpr bool operator<(InternedID other) const { return handle_ < other.handle_; }
+
+private:
+    uint32_t handle_ = InternTable::INVALID_HANDLE;
+};
+
+using UserHandle = InternedID<IdKind::USER>;
+using RoomHandle = InternedID<IdKind::ROOM>;
+using EventHandle = InternedID<IdKind::EVENT>;
+using DeviceHandle = InternedID<IdKind::DEVICE>;
+using ServerHandle = InternedID<IdKind::SERVER>;
+
+}
+
+namespace std {
+
+template<matrix::IdKind Kind>
+struct hash<matrix::InternedID<Kind>> {
+    size_t operator()(matrix::InternedID<Kind> id) const noexcept {
+        return static_cast<size_t>(id.handle()) * 0x9E3779B97F4A7C15ull;
+    }
+};
+
+}
\ No newline at end of file
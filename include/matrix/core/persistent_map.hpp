@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace matrix {
+
+// Persistent hash array mapped trie keyed by string. Copies share the whole
+// trie; set/erase copy only the nodes on the path to the key (at most
+// HASH_BITS / BITS + 1 of them, each holding <= 32 slots), so an older copy
+// keeps seeing the old contents and can be read from any thread without
+// locking. Keys whose hashes agree in every bit end up in a collision list
+// below the last level.
+template<typename V>
+class PersistentMap {
+public:
+    PersistentMap() = default;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const V* find(std::string_view key) const {
+        const size_t hash = hash_key(key);
+        const Node* node = root_.get();
+        for (unsigned shift = 0; node != nullptr; shift += BITS) {
+            if (shift >= HASH_BITS) {
+                for (const auto& leaf : node->collisions) {
+                    if (leaf->key == key) {
+                        return &leaf->value;
+                    }
+                }
+                return nullptr;
+            }
+            const uint32_t bit = bit_for(hash, shift);
+            if ((node->bitmap & bit) == 0) {
+                return nullptr;
+            }
+            const Slot& slot = node->slots[slot_index(node->bitmap, bit)];
+            if (slot.leaf) {
+                return slot.leaf->hash == hash && slot.leaf->key == key ? &slot.leaf->value : nullptr;
+            }
+            node = slot.child.get();
+        }
+        return nullptr;
+    }
+
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    void set(std::string_view key, V value) {
+        bool added = false;
+        root_ = insert(root_.get(), 0, hash_key(key), key, std::move(value), added);
+        if (added) {
+            ++size_;
+        }
+    }
+
+    bool erase(std::string_view key) {
+        bool removed = false;
+        root_ = remove(root_, 0, hash_key(key), key, removed);
+        if (removed) {
+            --size_;
+        }
+        return removed;
+    }
+
+    void clear() {
+        root_.reset();
+        size_ = 0;
+    }
+
+    // fn(const std::string& key, const V& value); order is by hash, not key.
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        visit(root_.get(), fn);
+    }
+
+    bool shares_root_with(const PersistentMap& other) const { return root_ == other.root_; }
+
+private:
+    static constexpr unsigned BITS = 5;
+    static constexpr unsigned HASH_BITS = sizeof(size_t) * 8;
+
+    struct Leaf {
+        size_t hash;
+        std::string key;
+        V value;
+    };
+
+    struct Node;
+    using LeafPtr = std::shared_ptr<const Leaf>;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Slot {
+        NodePtr child;
+        LeafPtr leaf;
+    };
+
+    struct Node {
+        uint32_t bitmap = 0;
+        std::vector<Slot> slots;
+        std::vector<LeafPtr> collisions;
+    };
+
+    NodePtr root_;
+    size_t size_ = 0;
+
+    static size_t hash_key(std::string_view key) { return std::hash<std::string_view>{}(key); }
+    static uint32_t bit_for(size_t hash, unsigned shift) { return 1u << ((hash >> shift) & 31u); }
+
+    static size_t slot_index(uint32_t bitmap, uint32_t bit) {
+        uint32_t below = bitmap & (bit - 1);
+        below = below - ((below >> 1) & 0x55555555u);
+        below = (below & 0x33333333u) + ((below >> 2) & 0x33333333u);
+        return static_cast<size_t>((((below + (below >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+    }
+
+    static LeafPtr make_leaf(size_t hash, std::string_view key, V&& value) {
+        return std::make_shared<const Leaf>(Leaf{hash, std::string(key), std::move(value)});
+    }
+
+    static NodePtr push_down(const LeafPtr& leaf, unsigned shift) {
+        auto node = std::make_shared<Node>();
+        if (shift >= HASH_BITS) {
+            node->collisions.push_back(leaf);
+        } else {
+            node->bitmap = bit_for(leaf->hash, shift);
+            node->slots.push_back(Slot{nullptr, leaf});
+        }
+        return node;
+    }
+
+    static NodePtr insert(const Node* node, unsigned shift, size_t hash, std::string_view key, V&& value, bool& added) {
+        auto copy = node != nullptr ? std::make_shared<Node>(*node) : std::make_shared<Node>();
+
+        if (shift >= HASH_BITS) {
+            for (auto& leaf : copy->collisions) {
+                if (leaf->key == key) {
+                    leaf = make_leaf(hash, key, std::move(value));
+                    return copy;
+                }
+            }
+            copy->collisions.push_back(make_leaf(hash, key, std::move(value)));
+            added = true;
+            return copy;
+        }
+
+        const uint32_t bit = bit_for(hash, shift);
+        const size_t index = slot_index(copy->bitmap, bit);
+        if ((copy->bitmap & bit) == 0) {
+            copy->bitmap |= bit;
+            copy->slots.insert(copy->slots.begin() + index, Slot{nullptr, make_leaf(hash, key, std::move(value))});
+            added = true;
+            return copy;
+        }
+
+        Slot& slot = copy->slots[index];
+        if (slot.leaf) {
+            if (slot.leaf->hash == hash && slot.leaf->key == key) {
+                slot.leaf = make_leaf(hash, key, std::move(value));
+                return copy;
+            }
+            NodePtr child = push_down(slot.leaf, shift + BITS);
+            slot.leaf.reset();
+            slot.child = insert(child.get(), shift + BITS, hash, key, std::move(value), added);
+            return copy;
+        }
+
+        slot.child = insert(slot.child.get(), shift + BITS, hash, key, std::move(value), added);
+        return copy;
+    }
+
+    static NodePtr remove(const NodePtr& node, unsigned shift, size_t hash, std::string_view key, bool& removed) {
+        if (!node) {
+            return node;
+        }
+
+        if (shift >= HASH_BITS) {
+            const auto it = std::find_if(node->collisions.begin(), node->collisions.end(),
+                                         [&](const LeafPtr& leaf) { return leaf->key == key; });
+            if (it == node->collisions.end()) {
+                return node;
+            }
+            removed = true;
+            if (node->collisions.size() == 1) {
+                return nullptr;
+            }
+            auto copy = std::make_shared<Node>(*node);
+            copy->collisions.erase(copy->collisions.begin() + (it - node->collisions.begin()));
+            return copy;
+        }
+
+        const uint32_t bit = bit_for(hash, shift);
+        if ((node->bitmap & bit) == 0) {
+            return node;
+        }
+        const size_t index = slot_index(node->bitmap, bit);
+        const Slot& slot = node->slots[index];
+
+        Slot replacement;
+        if (slot.leaf) {
+            if (slot.leaf->hash != hash || slot.leaf->key != key) {
+                return node;
+            }
+            removed = true;
+        } else {
+            NodePtr child = remove(slot.child, shift + BITS, hash, key, removed);
+            if (!removed) {
+                return node;
+            }
+            // A child left holding one leaf is folded back into this slot.
+            if (child && child->slots.size() == 1 && child->slots[0].leaf && child->collisions.empty()) {
+                replacement.leaf = child->slots[0].leaf;
+            } else if (child && child->slots.empty() && child->collisions.size() == 1) {
+                replacement.leaf = child->collisions[0];
+            } else {
+                replacement.child = std::move(child);
+            }
+        }
+
+        auto copy = std::make_shared<Node>(*node);
+        if (replacement.leaf || replacement.child) {
+            copy->slots[index] = std::move(replacement);
+            return copy;
+        }
+        copy->bitmap &= ~bit;
+        copy->slots.erase(copy->slots.begin() + index);
+        if (copy->slots.empty()) {
+            return nullptr;
+        }
+        return copy;
+    }
+
+    template<typename Fn>
+    static void visit(const Node* node, Fn& fn) {
+        if (node == nullptr) {
+            return;
+        }
+        for (const auto& slot : node->slots) {
+            if (slot.leaf) {
+                fn(slot.leaf->key, slot.leaf->value);
+            } else {
+                visit(slot.child.get(), fn);
+            }
+        }
+        for (const auto& leaf : node->collisions) {
+            fn(leaf->key, leaf->value);
+        }
+    }
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace matrix {
+
+// Reference count embedded in the object itself, so an owning pointer is a
+// single word and creating one needs no separate control block allocation.
+class RefCounted {
+public:
+    void add_ref() const { refs_.fetch_add(1, std::memory_order_relaxed); }
+    bool release_ref() const { return refs_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    uint32_t ref_count() const { return refs_.load(std::memory_order_relaxed); }
+
+protected:
+    RefCounted() = default;
+    RefCounted(const RefCounted&) {}
+    RefCounted& operator=(const RefCounted&) { return *this; }
+    ~RefCounted() = default;
+
+private:
+    mutable std::atomic<uint32_t> refs_{0};
+};
+
+// Objects are released through an ADL-found intrusive_destroy(const T*), which
+// lets arena-owned objects return their storage to the arena instead of the heap.
+template<typename T>
+class IntrusivePtr {
+public:
+    IntrusivePtr() = default;
+    IntrusivePtr(std::nullptr_t) {}
+    explicit IntrusivePtr(T* ptr) : ptr_(ptr) { retain(); }
+
+    IntrusivePtr(const IntrusivePtr& other) : ptr_(other.ptr_) { retain(); }
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+    template<typename U>
+    IntrusivePtr(const IntrusivePtr<U>& other) : ptr_(other.get()) { retain(); }
+
+    ~IntrusivePtr() { release(); }
+
+    IntrusivePtr& operator=(IntrusivePtr other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        return *this;
+    }
+
+    T* get() const { return ptr_; }
+    T& operator*() const { return *ptr_; }
+    T* operator->() const { return ptr_; }
+    explicit operator bool() const { return ptr_ != nullptr; }
+
+    void reset() { IntrusivePtr().swap(*this); }
+    void swap(IntrusivePtr& other) noexcept { std::swap(ptr_, other.ptr_); }
+
+    bool operator==(const IntrusivePtr& other) const { return ptr_ == other.ptr_; }
+    bool operator!=(const IntrusivePtr& other) const { return ptr_ != other.ptr_; }
+
+private:
+    T* ptr_ = nullptr;
+
+    void retain() {
+        if (ptr_) {
+            ptr_->add_ref();
+        }
+    }
+
+    void release() {
+        if (ptr_ && ptr_->release_ref()) {
+            intrusive_destroy(ptr_);
+        }
+    }
+};
+
+}
+
+namespace std {
+
+template<typename T>
+struct hash<matrix::IntrusivePtr<T>> {
+    size_t operator()(const matrix::IntrusivePtr<T>& ptr) const noexcept {
+        return std::hash<T*>()(ptr.get());
+    }
+};
+
+}
\ No newline at end of file
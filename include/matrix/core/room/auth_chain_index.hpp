@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../types.hpp"
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+struct ChainPosition {
+    uint32_t chain = 0;
+    uint32_t sequence = 0;
+};
+
+// Chain cover of a room's auth DAG. Events with the same (type, state_key)
+// whose auth events include the previous one form a chain, numbered 1, 2, ...
+// along it; every other auth edge is a link (origin chain, seq) -> (target
+// chain, seq). Anything reachable from an event is summarised by the highest
+// sequence reachable in each chain. Building B's summary follows the links
+// out of B's chain and the chains they reach, so it costs O(#chains + links)
+// in the worst case; "is A in the auth chain of B" is then one comparison
+// against it. The auth difference of several state sets is, per chain, the
+// sequence range between the smallest and largest summary.
+class AuthChainIndex {
+public:
+    struct Link {
+        uint32_t origin_chain;
+        uint32_t origin_sequence;
+        uint32_t target_chain;
+        uint32_t target_sequence;
+    };
+
+    // type and state_key are the chain's key; they are not stored with the
+    // row but joined from the event when it is read back.
+    struct Row {
+        EventID event_id;
+        uint32_t chain;
+        uint32_t sequence;
+        std::string type;
+        std::string state_key;
+    };
+
+    // Highest reachable sequence per chain, indexed by chain id; 0 = none.
+    using Reach = std::vector<uint32_t>;
+
+    explicit AuthChainIndex(RoomHandle room);
+
+    RoomHandle room() const { return room_; }
+
+    // Auth events must already be indexed.
+    ChainPosition add_event(EventHandle event, std::string_view type, std::string_view state_key,
+                            const std::vector<EventHandle>& auth_events);
+
+    std::optional<ChainPosition> position(EventHandle event) const;
+    bool contains(EventHandle event) const { return position(event).has_value(); }
+    size_t size() const;
+    size_t chain_count() const;
+
+    Reach reach(const std::vector<EventHandle>& events) const;
+    bool is_in_auth_chain(EventHandle ancestor, EventHandle descendant) const;
+    std::vector<EventHandle> auth_chain(const std::vector<EventHandle>& events) const;
+    std::vector<EventHandle> auth_chain_difference(const std::vector<std::vector<EventHandle>>& state_sets) const;
+
+    // Rebuilds the chains, their keys and chain_tips_ from rows, so events
+    // added afterwards extend the loaded chains instead of starting new ones.
+    void load(const std::vector<Row>& rows, const std::vector<Link>& links);
+    // Rows and links added since the last drain, for the caller to persist.
+    void drain_unpersisted(std::vector<Row>& rows, std::vector<Link>& links);
+
+private:
+    struct Chain {
+        std::string key;
+        std::vector<EventHandle> events;
+        // Sorted by origin_sequence; only links not implied by an earlier
+        // link from the same chain are kept.
+        std::vector<Link> links;
+    };
+
+    RoomHandle room_;
+    mutable std::shared_mutex mutex_;
+
+    std::unordered_map<EventHandle, ChainPosition> positions_;
+    std::vector<Chain> chains_;
+    std::unordered_map<std::string, uint32_t> chain_tips_;
+
+    size_t persisted_rows_ = 0;
+    std::vector<Row> pending_rows_;
+    std::vector<Link> pending_links_;
+
+    void extend_reach(Reach& reach, uint32_t chain, uint32_t sequence) const;
+    void add_link(const Link& link);
+};
+
+// Persistence for chain cover indexes; implemented on top of the event
+// repositories.
+class AuthChainStore {
+public:
+    virtual ~AuthChainStore() = default;
+
+    virtual bool load_room(const RoomID& room_id, std::vector<AuthChainIndex::Row>& rows,
+                           std::vector<AuthChainIndex::Link>& links) = 0;
+    virtual bool store(const RoomID& room_id, const std::vector<AuthChainIndex::Row>& rows,
+                       const std::vector<AuthChainIndex::Link>& links) = 0;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../event/room_event.hpp"
+#include "../types.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+using EventIndex = uint32_t;
+
+// Per-room event DAG over dense integer indices. Events are appended in
+// arrival order, so each node's prev and auth edges are appended to CSR arrays
+// (offsets + targets) as the node is added. Edges to events that arrive later
+// (outliers, backfill) are parked in a small overflow map until compact()
+// folds them back into the CSR arrays; every traversal reads both. Edges are
+// only handed out under the read lock, never as pointers into the arrays.
+class EventGraph {
+public:
+    static constexpr EventIndex INVALID_INDEX = UINT32_MAX;
+
+    enum class EdgeKind : uint8_t {
+        PREV,
+        AUTH
+    };
+
+    explicit EventGraph(const RoomID& room_id);
+    ~EventGraph() = default;
+
+    RoomHandle room() const { return room_; }
+
+    EventIndex add_event(EventHandle event_id, int64_t depth,
+                         const std::vector<EventHandle>& prev_events,
+                         const std::vector<EventHandle>& auth_events);
+    EventIndex add_event(const RoomEvent& event);
+
+    EventIndex index_of(EventHandle event_id) const;
+    EventHandle event_at(EventIndex index) const;
+    bool contains(EventHandle event_id) const { return index_of(event_id) != INVALID_INDEX; }
+    size_t size() const;
+
+    int64_t depth(EventIndex index) const;
+    int64_t max_depth() const;
+    // Copies the CSR row and then any overflow edges for index into out,
+    // under the read lock.
+    void edges(EventIndex index, EdgeKind kind, std::vector<EventIndex>& out) const;
+    // Calls fn after the lock is released, so fn may call back into the graph.
+    void for_each_edge(EventIndex index, EdgeKind kind, const std::function<void(EventIndex)>& fn) const {
+        std::vector<EventIndex> targets;
+        edges(index, kind, targets);
+        for (EventIndex target : targets) {
+            fn(target);
+        }
+    }
+
+    std::vector<EventIndex> forward_extremities() const;
+    std::vector<EventHandle> missing_events() const;
+
+    bool is_ancestor(EventIndex ancestor, EventIndex descendant, EdgeKind kind = EdgeKind::PREV) const;
+    std::vector<EventIndex> ancestors(const std::vector<EventIndex>& from, EdgeKind kind, size_t limit = 0) const;
+    std::vector<EventIndex> auth_chain(const std::vector<EventIndex>& from) const { return ancestors(from, EdgeKind::AUTH); }
+
+    // Breadth-first walk back from `from` in descending depth order, as
+    // needed for /backfill and /get_missing_events.
+    std::vector<EventIndex> walk_by_depth(const std::vector<EventIndex>& from, size_t limit,
+                                          const std::vector<EventIndex>& stop_at = {}) const;
+
+    void compact();
+    size_t memory_usage() const;
+
+private:
+    struct EdgeRange {
+        const EventIndex* first = nullptr;
+        const EventIndex* last = nullptr;
+
+        const EventIndex* begin() const { return first; }
+        const EventIndex* end() const { return last; }
+    };
+
+    struct Csr {
+        std::vector<uint32_t> offsets{0};
+        std::vector<EventIndex> targets;
+        std::unordered_map<EventIndex, std::vector<EventIndex>> overflow;
+
+        void append_row(const std::vector<EventIndex>& row);
+        EdgeRange row(EventIndex index) const;
+    };
+
+    RoomHandle room_;
+    mutable std::shared_mutex mutex_;
+
+    std::vector<EventHandle> events_;
+    std::vector<int64_t> depths_;
+    std::vector<bool> has_children_;
+    std::unordered_map<EventHandle, EventIndex> index_;
+
+    Csr prev_;
+    Csr auth_;
+
+    // Edges whose target has not been seen yet: target -> (source, kind).
+    std::unordered_map<EventHandle, std::vector<std::pair<EventIndex, EdgeKind>>> pending_edges_;
+
+    const Csr& csr(EdgeKind kind) const { return kind == EdgeKind::PREV ? prev_ : auth_; }
+    Csr& csr(EdgeKind kind) { return kind == EdgeKind::PREV ? prev_ : auth_; }
+
+    std::vector<EventIndex> resolve_edges(EventIndex source, const std::vector<EventHandle>& targets, EdgeKind kind);
+    void resolve_pending(EventHandle event_id, EventIndex index);
+    // Caller holds mutex_; fn must not call back into the graph.
+    void for_each_edge_locked(EventIndex index, EdgeKind kind, const std::function<void(EventIndex)>& fn) const;
+};
+
+using EventGraphPtr = std::shared_ptr<EventGraph>;
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../handle_bitmap.hpp"
+#include "../types.hpp"
+#include <array>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+// Single source of truth for room membership. For each membership state it
+// keeps room -> users and user -> rooms as HandleBitmaps, split over shards
+// keyed by handle like RoomManager. A user is in at most one state per room;
+// set_membership moves them between bitmaps under the room shard lock first
+// and the user shard lock second.
+class MembershipIndex {
+public:
+    static constexpr size_t SHARD_COUNT = 64;
+    static constexpr size_t MEMBERSHIP_STATES = 5;
+
+    MembershipIndex() = default;
+
+    static MembershipIndex& shared();
+
+    // Returns the previous membership, or std::nullopt if there was none.
+    std::optional<Membership> set_membership(RoomHandle room, UserHandle user, Membership membership);
+    std::optional<Membership> remove(RoomHandle room, UserHandle user);
+    std::optional<Membership> get_membership(RoomHandle room, UserHandle user) const;
+    void remove_room(RoomHandle room);
+
+    HandleBitmap members(RoomHandle room, Membership membership = Membership::JOIN) const;
+    HandleBitmap rooms(UserHandle user, Membership membership = Membership::JOIN) const;
+    size_t member_count(RoomHandle room, Membership membership = Membership::JOIN) const;
+
+    void for_each_member(RoomHandle room, Membership membership, const std::function<void(UserHandle)>& fn) const;
+    void for_each_room(UserHandle user, Membership membership, const std::function<void(RoomHandle)>& fn) const;
+
+    HandleBitmap shared_rooms(UserHandle a, UserHandle b) const;
+    bool share_room(UserHandle a, UserHandle b) const;
+    // Union of the joined members of every room U is joined to; feeds
+    // device list and presence fan-out.
+    HandleBitmap users_sharing_room(UserHandle user) const;
+
+    std::vector<UserID> member_ids(RoomHandle room, Membership membership = Membership::JOIN) const;
+    std::vector<RoomID> room_ids(UserHandle user, Membership membership = Membership::JOIN) const;
+
+private:
+    using Bitmaps = std::array<HandleBitmap, MEMBERSHIP_STATES>;
+
+    struct alignas(64) RoomShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<RoomHandle, Bitmaps> members;
+    };
+
+    struct alignas(64) UserShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<UserHandle, Bitmaps> rooms;
+    };
+
+    std::array<RoomShard, SHARD_COUNT> room_shards_;
+    std::array<UserShard, SHARD_COUNT> user_shards_;
+
+    static size_t state_index(Membership membership) { return static_cast<size_t>(membership); }
+
+    RoomShard& shard_for(RoomHandle room) { return room_shards_[room.handle() % SHARD_COUNT]; }
+    const RoomShard& shard_for(RoomHandle room) const { return room_shards_[room.handle() % SHARD_COUNT]; }
+    UserShard& shard_for(UserHandle user) { return user_shards_[user.handle() % SHARD_COUNT]; }
+    const UserShard& shard_for(UserHandle user) const { return user_shards_[user.handle() % SHARD_COUNT]; }
+};
+
+}
\ No newline at end of file
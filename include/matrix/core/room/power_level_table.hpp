@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../event/event_type.hpp"
+#include "../matrix_types.hpp"
+#include "../types.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace matrix {
+
+enum class RoomAction : uint8_t {
+    INVITE,
+    KICK,
+    BAN,
+    REDACT,
+    NOTIFY_ROOM,
+    COUNT
+};
+
+class PowerLevelTable;
+using PowerLevelTablePtr = std::shared_ptr<const PowerLevelTable>;
+
+// Immutable, compiled form of m.room.power_levels. Built once per power
+// levels change and shared by Room, RoomState, StateManager, RoomManager and
+// ClientApi; every check is a lookup in flat sorted or indexed arrays, with
+// no allocation and no string hashing for known event types.
+class PowerLevelTable {
+public:
+    static PowerLevelTablePtr compile(const PowerLevels& levels);
+    static PowerLevelTablePtr from_content(const nlohmann::json& content);
+    // Rules for a room with no power levels event: the creator has 100.
+    static PowerLevelTablePtr for_creator(UserHandle creator);
+    // Spec defaults, compiled once and shared.
+    static const PowerLevelTablePtr& defaults() {
+        static const PowerLevelTablePtr table = compile(PowerLevels());
+        return table;
+    }
+
+    const PowerLevels& levels() const { return levels_; }
+
+    int user_level(UserHandle user) const;
+    int event_level(EventType type, bool state_event) const;
+    int event_level(std::string_view type, bool state_event) const;
+    int action_level(RoomAction action) const { return actions_[static_cast<size_t>(action)]; }
+
+    bool can_send(UserHandle user, EventType type, bool state_event) const {
+        return user_level(user) >= event_level(type, state_event);
+    }
+    bool can_send(UserHandle user, std::string_view type, bool state_event) const {
+        return user_level(user) >= event_level(type, state_event);
+    }
+    bool can(UserHandle user, RoomAction action) const { return user_level(user) >= action_level(action); }
+
+    // Kicks and bans also need the target to be strictly below the actor.
+    bool can_act_on(UserHandle actor, UserHandle target, RoomAction action) const;
+
+private:
+    PowerLevelTable() = default;
+
+    PowerLevels levels_;
+    std::array<int, static_cast<size_t>(RoomAction::COUNT)> actions_{};
+    std::array<int, static_cast<size_t>(EventType::UNKNOWN) + 1> known_events_{};
+    uint64_t known_overridden_ = 0;
+    std::vector<std::pair<std::string, int>> custom_events_;
+    std::vector<std::pair<uint32_t, int>> users_;
+};
+
+}
\ No newline at end of file
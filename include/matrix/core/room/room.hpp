@@ -2,9 +2,15 @@
 
 #include "../event/event.hpp"
 #include "../matrix_types.hpp"
+#include "event_graph.hpp"
+#include "membership_index.hpp"
+#include "power_level_table.hpp"
+#include "room_summary.hpp"
+#include "room_timeline.hpp"
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <shared_mutex>
 
 namespace matrix {
 
@@ -12,47 +18,69 @@ class RoomState;
 
 class Room {
 public:
-    Room(const RoomID& room_id, const UserID& creator);
+    Room(const RoomID& room_id, const UserID& creator, MembershipIndex& memberships = MembershipIndex::shared());
     ~Room() = default;
 
-    RoomID room_id() const { return room_id_; }
-    UserID creator() const { return creator_; }
-    std::string name() const { return name_; }
-    std::string topic() const { return topic_; }
-    std::string avatar_url() const { return avatar_url_; }
-    std::string version() const { return version_; }
-    bool is_encrypted() const { return is_encrypted_; }
-    bool is_public() const { return is_public_; }
-    int num_joined_members() const { return num_joined_members_; }
-    std::string join_rules() const { return join_rules_; }
-    std::string guest_access() const { return guest_access_; }
-    std::string history_visibility() const { return history_visibility_; }
-
-    void set_name(const std::string& name) { name_ = name; }
-    void set_topic(const std::string& topic) { topic_ = topic; }
-    void set_avatar_url(const std::string& avatar_url) { avatar_url_ = avatar_url; }
-    void set_version(const std::string& version) { version_ = version; }
-    void set_encrypted(bool encrypted) { is_encrypted_ = encrypted; }
-    void set_public(bool is_public) { is_public_ = is_public; }
-    void set_num_joined_members(int count) { num_joined_members_ = count; }
-    void set_join_rules(const std::string& rules) { join_rules_ = rules; }
-    void set_guest_access(const std::string& access) { guest_access_ = access; }
-    void set_history_visibility(const std::string& visibility) { history_visibility_ = visibility; }
+    const RoomID& room_id() const { return room_id_.str(); }
+    RoomHandle room_handle() const { return room_id_; }
+    const UserID& creator() const { return creator_.str(); }
+    UserHandle creator_handle() const { return creator_; }
+    std::string name() const;
+    std::string topic() const;
+    std::string avatar_url() const;
+    std::string version() const;
+    bool is_encrypted() const;
+    bool is_public() const;
+    int num_joined_members() const { return static_cast<int>(summary()->joined_member_count); }
+    std::string join_rules() const;
+    std::string guest_access() const;
+    std::string history_visibility() const;
+
+    // Each setter takes the room lock and, for fields the summary carries,
+    // republishes the summary. They return true when the room's public
+    // directory entry may have changed; RoomManager's set_room_* wrappers
+    // refresh the directory in that case, so go through those for rooms it
+    // manages.
+    bool set_name(const std::string& name);
+    bool set_topic(const std::string& topic);
+    bool set_avatar_url(const std::string& avatar_url);
+    void set_version(const std::string& version);
+    bool set_encrypted(bool encrypted);
+    bool set_public(bool is_public);
+    bool set_join_rules(const std::string& rules);
+    bool set_guest_access(const std::string& access);
+    bool set_history_visibility(const std::string& visibility);
 
     bool add_member(const UserID& user_id, Membership membership);
     bool remove_member(const UserID& user_id);
     Membership get_membership(const UserID& user_id) const;
+    Membership get_membership(UserHandle user) const;
     std::vector<UserID> get_members(Membership membership) const;
     std::vector<UserID> get_joined_members() const;
     std::vector<UserID> get_invited_members() const;
+    HandleBitmap get_member_handles(Membership membership = Membership::JOIN) const { return memberships_.members(room_id_, membership); }
 
     bool add_event(const EventPtr& event);
+    bool add_event(const EventPtr& event, StreamOrdering ordering);
+    // Allocates the ordering from stream under the room lock, so concurrent
+    // sends reach the timeline in ordering order, and completes it once the
+    // event is appended. Returns the ordering, or 0 if the event was rejected;
+    // a rejected event's ordering is completed too, so current() moves past
+    // the gap instead of stalling.
+    StreamOrdering add_event(const EventPtr& event, StreamIdGenerator& stream);
     EventPtr get_event(const EventID& event_id) const;
+    StreamOrdering get_stream_ordering(const EventID& event_id) const;
     std::vector<EventPtr> get_events() const;
-    std::vector<EventPtr> get_events_since(const std::string& since_token) const;
+    RoomTimeline::Range get_events_since(StreamOrdering since, size_t limit = 0) const { return timeline_.since(since, limit); }
+    const RoomTimeline& timeline() const { return timeline_; }
+    RoomTimeline& timeline() { return timeline_; }
 
-    PowerLevels power_levels() const { return power_levels_; }
-    void set_power_levels(const PowerLevels& levels) { power_levels_ = levels; }
+    PowerLevelTablePtr power_table() const { return std::atomic_load(&power_table_); }
+    PowerLevels power_levels() const { return power_table()->levels(); }
+    void set_power_levels(const PowerLevels& levels) { set_power_table(PowerLevelTable::compile(levels)); }
+    void set_power_table(PowerLevelTablePtr table) {
+        std::atomic_store(&power_table_, table ? std::move(table) : PowerLevelTable::for_creator(creator_));
+    }
 
     int get_user_power_level(const UserID& user_id) const;
     bool user_can_send_event(const UserID& user_id, const std::string& event_type) const;
@@ -61,38 +89,45 @@ public:
     bool user_can_kick(const UserID& user_id) const;
     bool user_can_redact(const UserID& user_id) const;
 
+    EventGraphPtr graph() const { return graph_; }
+    RoomSummaryPtr summary() const { return summary_.snapshot(); }
+
     std::shared_ptr<RoomState> current_state() const;
     void update_state(const EventPtr& state_event);
 
-    std::string get_prev_batch() const { return prev_batch_; }
-    void set_prev_batch(const std::string& batch) { prev_batch_ = batch; }
+    std::string get_prev_batch() const;
+    void set_prev_batch(const std::string& batch);
 
     nlohmann::json to_json() const;
     void from_json(const nlohmann::json& j);
 
 private:
-    RoomID room_id_;
-    UserID creator_;
+    RoomHandle room_id_;
+    UserHandle creator_;
     std::string name_;
     std::string topic_;
     std::string avatar_url_;
     std::string version_ = "1";
     bool is_encrypted_ = false;
     bool is_public_ = false;
-    int num_joined_members_ = 0;
     std::string join_rules_ = "invite";
     std::string guest_access_ = "forbidden";
     std::string history_visibility_ = "shared";
     std::string prev_batch_;
 
-    PowerLevels power_levels_;
-    std::unordered_map<UserID, Membership> members_;
-    std::unordered_map<EventID, EventPtr> events_;
-    std::vector<EventID> event_order_;
+    // Guards the fields above, members, power levels, state and the event
+    // ordering index. Readers of the timeline itself do not take it.
+    mutable std::shared_mutex mutex_;
 
-    std::shared_ptr<RoomState> current_state_;
+    // Never null: the creator's defaults until power levels are set.
+    PowerLevelTablePtr power_table_ = PowerLevelTable::for_creator(creator_);
+    MembershipIndex& memberships_;
+    RoomTimeline timeline_;
+    std::unordered_map<EventHandle, StreamOrdering> event_orderings_;
 
-    void update_member_count();
+    std::shared_ptr<RoomState> current_state_;
+    EventGraphPtr graph_;
+    RoomSummaryTracker summary_;
 };
 
 using RoomPtr = std::shared_ptr<Room>;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "room_manager.hpp"
+#include <string>
+#include <vector>
+
+namespace matrix {
+
+struct RoomBenchmarkWorkload {
+    size_t rooms = 1000;
+    size_t users = 10000;
+    size_t rooms_per_user = 20;
+    size_t operations_per_thread = 100000;
+    // Fraction of operations that are add_event_to_room; the rest are
+    // get_rooms_for_user, roughly the send/sync mix of a busy server.
+    double write_ratio = 0.2;
+};
+
+class RoomManagerBenchmark {
+public:
+    struct BenchmarkResult {
+        std::string name;
+        size_t threads;
+        size_t operations;
+        int64_t time_ns;
+        double operations_per_second;
+        double speedup;
+    };
+
+    using Workload = RoomBenchmarkWorkload;
+
+    RoomManagerBenchmark();
+    ~RoomManagerBenchmark();
+
+    // Runs the same mixed workload at 1, 2, 4, ... threads up to
+    // hardware_concurrency and reports throughput relative to one thread.
+    std::vector<BenchmarkResult> benchmark_scaling(const Workload& workload = Workload());
+    BenchmarkResult benchmark_mixed(size_t threads, const Workload& workload = Workload());
+
+    nlohmann::json get_benchmark_results() const;
+
+private:
+    std::vector<BenchmarkResult> results_;
+
+    std::shared_ptr<RoomManager> populate(const Workload& workload,
+                                          std::vector<RoomID>& room_ids,
+                                          std::vector<UserID>& user_ids) const;
+};
+
+}
\ No newline at end of file
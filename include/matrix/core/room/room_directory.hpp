@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../handle_bitmap.hpp"
+#include "../matrix_types.hpp"
+#include "room_summary.hpp"
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+// Public room directory kept in num_joined_members order and updated as rooms
+// change rather than rebuilt per request.
+//
+// Pages are cut by key, not offset: next_batch names the last (members,
+// room_id) returned, and the next page starts strictly after it, so rooms
+// moving around between requests never cause repeats within a walk.
+//
+// The filter is matched case-insensitively as a substring of name, topic,
+// canonical alias or aliases. Filters of three or more characters are
+// narrowed first by intersecting the trigram bitmaps, and only the survivors
+// are checked against the text.
+class RoomDirectory {
+public:
+    struct Page {
+        std::vector<PublicRoom> chunk;
+        std::string next_batch;
+        std::string prev_batch;
+        size_t total_room_count_estimate = 0;
+    };
+
+    RoomDirectory() = default;
+
+    void upsert(const PublicRoom& room);
+    void upsert(const RoomSummary& summary) { upsert(summary.to_public_room()); }
+    bool update_member_count(RoomHandle room, int num_joined_members);
+    bool remove(RoomHandle room);
+    bool contains(RoomHandle room) const;
+    size_t size() const;
+
+    Page query(size_t limit, std::string_view since = {}, std::string_view filter = {}) const;
+
+    static std::string encode_cursor(int num_joined_members, const RoomID& room_id, bool forward = true);
+
+private:
+    struct Key {
+        int num_joined_members;
+        RoomHandle room;
+    };
+
+    // A decoded since token. The room id stays a string: it comes from the
+    // client and is compared, never interned.
+    struct Cursor {
+        int num_joined_members;
+        std::string room_id;
+        bool forward = true;
+    };
+
+    // Most members first, then room id; Cursor keys seek without interning.
+    struct KeyOrder {
+        using is_transparent = void;
+
+        static bool before(int a_members, std::string_view a_id, int b_members, std::string_view b_id) {
+            if (a_members != b_members) {
+                return a_members > b_members;
+            }
+            return a_id < b_id;
+        }
+
+        bool operator()(const Key& a, const Key& b) const {
+            return before(a.num_joined_members, a.room.view(), b.num_joined_members, b.room.view());
+        }
+        bool operator()(const Key& a, const Cursor& b) const {
+            return before(a.num_joined_members, a.room.view(), b.num_joined_members, b.room_id);
+        }
+        bool operator()(const Cursor& a, const Key& b) const {
+            return before(a.num_joined_members, a.room_id, b.num_joined_members, b.room.view());
+        }
+    };
+
+    struct Entry {
+        PublicRoom room;
+        std::string search_text;
+        std::vector<uint32_t> trigrams;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::set<Key, KeyOrder> order_;
+    std::unordered_map<RoomHandle, Entry> entries_;
+    std::unordered_map<uint32_t, HandleBitmap> trigram_index_;
+
+    void index_text(RoomHandle room, Entry& entry);
+    void unindex_text(RoomHandle room, const Entry& entry);
+    std::optional<HandleBitmap> filter_candidates(std::string_view folded_filter) const;
+
+    static std::string fold(std::string_view text);
+    static std::vector<uint32_t> trigrams_of(std::string_view folded);
+    static std::optional<Cursor> decode_cursor(std::string_view cursor);
+};
+
+}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "room.hpp"
+#include "room_directory.hpp"
 #include "../event/event.hpp"
+#include "../stream_token.hpp"
+#include <array>
 #include <unordered_map>
 #include <memory>
 #include <shared_mutex>
@@ -10,7 +13,8 @@ namespace matrix {
 
 class RoomManager {
 public:
-    RoomManager();
+    explicit RoomManager(StreamIdGenerators& streams = StreamIdGenerators::shared(),
+                         MembershipIndex& memberships = MembershipIndex::shared());
     ~RoomManager() = default;
 
     RoomPtr create_room(const UserID& creator, const std::string& name = "", bool is_public = false);
@@ -20,6 +24,9 @@ public:
 
     std::vector<RoomPtr> get_rooms() const;
     std::vector<RoomPtr> get_rooms_for_user(const UserID& user_id) const;
+    HandleBitmap get_room_handles_for_user(UserHandle user, Membership membership = Membership::JOIN) const { return memberships_.rooms(user, membership); }
+    HandleBitmap get_users_sharing_room(UserHandle user) const { return memberships_.users_sharing_room(user); }
+    bool users_share_room(UserHandle a, UserHandle b) const { return memberships_.share_room(a, b); }
     std::vector<RoomPtr> get_public_rooms() const;
 
     bool add_user_to_room(const RoomID& room_id, const UserID& user_id, Membership membership);
@@ -27,9 +34,11 @@ public:
     Membership get_user_membership(const RoomID& room_id, const UserID& user_id) const;
 
     bool add_event_to_room(const RoomID& room_id, const EventPtr& event);
+    StreamOrdering current_stream_ordering() const { return streams_[StreamId::EVENTS].current(); }
     EventPtr get_room_event(const RoomID& room_id, const EventID& event_id) const;
     std::vector<EventPtr> get_room_events(const RoomID& room_id) const;
-    std::vector<EventPtr> get_room_events_since(const RoomID& room_id, const std::string& since_token) const;
+    RoomTimeline::Range get_room_events_since(const RoomID& room_id, const StreamToken& since, size_t limit = 0) const;
+    EventGraphPtr get_room_graph(const RoomID& room_id) const;
 
     std::vector<RoomPtr> get_joined_rooms(const UserID& user_id) const;
     std::vector<RoomPtr> get_invited_rooms(const UserID& user_id) const;
@@ -41,26 +50,65 @@ public:
     bool user_can_redact(const RoomID& room_id, const UserID& user_id) const;
 
     PowerLevels get_room_power_levels(const RoomID& room_id) const;
+    PowerLevelTablePtr get_room_power_table(const RoomID& room_id) const;
     void set_room_power_levels(const RoomID& room_id, const PowerLevels& levels);
 
     std::string resolve_room_alias(const std::string& room_alias) const;
     bool set_room_alias(const RoomID& room_id, const std::string& room_alias);
     bool remove_room_alias(const std::string& room_alias);
 
-    nlohmann::json get_room_summary(const RoomID& room_id) const;
-    nlohmann::json get_public_rooms_list(int limit = 50, const std::string& since = "") const;
-
+    // Room field setters that also keep the directory entry current.
+    bool set_room_name(const RoomID& room_id, const std::string& name);
+    bool set_room_topic(const RoomID& room_id, const std::string& topic);
+    bool set_room_avatar_url(const RoomID& room_id, const std::string& avatar_url);
+    bool set_room_public(const RoomID& room_id, bool is_public);
+    bool set_room_join_rules(const RoomID& room_id, const std::string& rules);
+    bool set_room_guest_access(const RoomID& room_id, const std::string& access);
+    bool set_room_history_visibility(const RoomID& room_id, const std::string& visibility);
+
+    RoomSummaryPtr get_room_summary(const RoomID& room_id) const;
+    nlohmann::json get_public_rooms_list(int limit = 50, const std::string& since = "", const std::string& filter = "") const;
+    RoomDirectory::Page query_room_directory(size_t limit, const std::string& since, const std::string& filter) const;
+
+    // Spills everything past max_events in the room's timeline to the cold
+    // store; without one attached the events are dropped as before.
     void cleanup_old_events(const RoomID& room_id, int max_events = 10000);
+    // Attaches store to every room and reattaches the chunks it already
+    // holds for each; remove_room() drops the room's chunks from it.
+    void set_timeline_cold_store(std::shared_ptr<TimelineColdStore> store,
+                                 const RoomTimeline::TieringPolicy& policy = RoomTimeline::TieringPolicy());
 
 private:
-    mutable std::shared_mutex mutex_;
-    std::unordered_map<RoomID, RoomPtr> rooms_;
-    std::unordered_map<std::string, RoomID> room_aliases_;
-    std::unordered_map<UserID, std::vector<RoomID>> user_rooms_;
-
-    RoomPtr create_room_internal(const RoomID& room_id, const UserID& creator);
-    void update_user_room_membership(const RoomID& room_id, const UserID& user_id, Membership membership);
-    void remove_user_room_membership(const RoomID& room_id, const UserID& user_id);
+    // Rooms are split over independently locked shards keyed by handle, so
+    // sends and syncs in unrelated rooms do not contend. A shard lock is only
+    // held for the map lookup; work on a room happens under the Room's own
+    // lock. Membership lives in MembershipIndex, which shards the same way.
+    static constexpr size_t SHARD_COUNT = 64;
+
+    struct alignas(64) RoomShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<RoomHandle, RoomPtr> rooms;
+    };
+
+    std::array<RoomShard, SHARD_COUNT> room_shards_;
+
+    mutable std::shared_mutex alias_mutex_;
+    std::unordered_map<std::string, RoomHandle> room_aliases_;
+
+    StreamIdGenerators& streams_;
+    MembershipIndex& memberships_;
+    RoomDirectory directory_;
+    std::shared_ptr<TimelineColdStore> cold_store_;
+    RoomTimeline::TieringPolicy tiering_policy_;
+
+    RoomShard& shard_for(RoomHandle room) { return room_shards_[room.handle() % SHARD_COUNT]; }
+    const RoomShard& shard_for(RoomHandle room) const { return room_shards_[room.handle() % SHARD_COUNT]; }
+
+    RoomPtr create_room_internal(RoomHandle room, UserHandle creator);
+    RoomPtr find_room(RoomHandle room) const;
+    // Called after anything that changes a room's directory entry: joins and
+    // leaves, visibility, name, topic, avatar and alias changes.
+    void update_directory_entry(const Room& room, const RoomSummary& summary);
 };
 
 }
\ No newline at end of file
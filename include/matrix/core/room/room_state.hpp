@@ -2,15 +2,26 @@
 
 #include "../event/event.hpp"
 #include "../matrix_types.hpp"
+#include "../persistent_map.hpp"
+#include "power_level_table.hpp"
 #include <unordered_map>
 #include <vector>
 #include <memory>
 
 namespace matrix {
 
+// Current state keyed by (type, state_key) in a two-level PersistentMap. A
+// copy shares the tries with its source, so snapshots cost O(1) and each
+// applied event copies only the nodes on its path; a snapshot handed to a
+// reader is never modified afterwards and needs no lock.
 class RoomState {
 public:
+    using StateKeyMap = PersistentMap<EventPtr>;
+    using StateTypeMap = PersistentMap<StateKeyMap>;
+
     RoomState(const RoomID& room_id);
+    RoomState(const RoomState&) = default;
+    RoomState& operator=(const RoomState&) = default;
     ~RoomState() = default;
 
     RoomID room_id() const { return room_id_; }
@@ -27,7 +38,10 @@ public:
     std::vector<UserID> get_banned_members() const;
     Membership get_membership(const UserID& user_id) const;
 
-    PowerLevels power_levels() const;
+    // By value: applying a power levels event replaces the table, so a
+    // reference into it would dangle. Hold power_table() to avoid the copy.
+    PowerLevels power_levels() const { return power_table_->levels(); }
+    PowerLevelTablePtr power_table() const { return power_table_; }
     int get_user_power_level(const UserID& user_id) const;
     int get_event_power_level(const std::string& event_type) const;
 
@@ -48,14 +62,25 @@ public:
     bool user_can_redact(const UserID& user_id) const;
 
     nlohmann::json to_json() const;
-    std::shared_ptr<RoomState> copy() const;
+    std::shared_ptr<RoomState> copy() const { return std::make_shared<RoomState>(*this); }
+    std::shared_ptr<const RoomState> snapshot() const { return std::make_shared<const RoomState>(*this); }
+
+    template<typename Fn>
+    void for_each_state_event(Fn&& fn) const {
+        state_events_.for_each([&](const std::string&, const StateKeyMap& keys) {
+            keys.for_each([&](const std::string&, const EventPtr& event) { fn(event); });
+        });
+    }
 
-    size_t size() const { return state_events_.size(); }
+    size_t size() const { return event_count_; }
     void clear();
 
 private:
     RoomID room_id_;
-    std::unordered_map<std::string, std::unordered_map<std::string, EventPtr>> state_events_;
+    StateTypeMap state_events_;
+    size_t event_count_ = 0;
+    // Never null: spec defaults until an m.room.power_levels event arrives.
+    PowerLevelTablePtr power_table_ = PowerLevelTable::defaults();
 
     EventPtr get_power_levels_event() const;
     EventPtr get_join_rules_event() const;
@@ -72,5 +97,6 @@ private:
 };
 
 using RoomStatePtr = std::shared_ptr<RoomState>;
+using RoomStateSnapshot = std::shared_ptr<const RoomState>;
 
 }
\ No newline at end of file
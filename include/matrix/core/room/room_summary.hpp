@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../event/room_event.hpp"
+#include "../matrix_types.hpp"
+#include "../stream_token.hpp"
+#include "../types.hpp"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+class MembershipIndex;
+
+struct RoomSummary {
+    static constexpr size_t MAX_HEROES = 5;
+
+    RoomHandle room;
+    int64_t joined_member_count = 0;
+    int64_t invited_member_count = 0;
+    // Up to MAX_HEROES + 1 joined or invited members ordered by the stream
+    // ordering of their membership event, then by user id; the extra one lets
+    // heroes_for() drop the viewer and still return five.
+    std::vector<UserHandle> hero_candidates;
+    std::string name;
+    std::string topic;
+    std::string avatar_url;
+    std::string canonical_alias;
+    std::string join_rules = "invite";
+    std::string room_type;
+    bool is_encrypted = false;
+    bool world_readable = false;
+    bool guest_can_join = false;
+    StreamOrdering updated_at = 0;
+
+    std::vector<UserHandle> heroes_for(UserHandle viewer) const;
+
+    nlohmann::json to_sync_json(UserHandle viewer) const;
+    nlohmann::json to_hierarchy_json() const;
+    PublicRoom to_public_room() const;
+};
+
+using RoomSummaryPtr = std::shared_ptr<const RoomSummary>;
+
+// Keeps a room's summary current as events are applied. The writer (under
+// the Room lock) edits a private copy and publishes it with an atomic store;
+// readers take the published pointer and never see a half-applied update.
+class RoomSummaryTracker {
+public:
+    explicit RoomSummaryTracker(RoomHandle room);
+
+    RoomSummaryPtr snapshot() const { return std::atomic_load(&published_); }
+
+    // Return true if the summary changed and was republished.
+    bool apply_state_event(const RoomEvent& event, StreamOrdering ordering);
+    bool apply_membership(UserHandle user, std::optional<Membership> previous, Membership current,
+                          StreamOrdering ordering, const MembershipIndex& memberships);
+    // For changes made outside the event path, such as Room's setters; edit
+    // returns whether it changed anything.
+    bool update(const std::function<bool(RoomSummary&)>& edit, StreamOrdering ordering);
+
+private:
+    struct HeroKey {
+        StreamOrdering since;
+        UserHandle user;
+    };
+
+    struct HeroOrder {
+        bool operator()(const HeroKey& a, const HeroKey& b) const {
+            if (a.since != b.since) {
+                return a.since < b.since;
+            }
+            return a.user.view() < b.user.view();
+        }
+    };
+
+    using HeroSet = std::set<HeroKey, HeroOrder>;
+
+    RoomSummary working_;
+    RoomSummaryPtr published_;
+    // Joined and invited members by (ordering of their membership event, user
+    // id), kept as memberships change, with each member's node for O(log n)
+    // removal. MembershipIndex answers who is a member; this only adds the
+    // order the spec picks heroes in.
+    HeroSet hero_order_;
+    std::unordered_map<UserHandle, HeroSet::iterator> hero_nodes_;
+
+    void publish(StreamOrdering ordering);
+    // Copies the first MAX_HEROES + 1 entries of hero_order_.
+    void refill_heroes();
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "../event/event.hpp"
+#include "../stream_token.hpp"
+#include "timeline_cold_store.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace matrix {
+
+struct TimelineTieringPolicy {
+    size_t hot_chunks = 40;
+    size_t paged_in_chunks = 8;
+};
+
+// Append-only room timeline made of fixed-size chunks. A slot is written once
+// and then published by bumping the chunk's count with release ordering, so
+// everything below the count is immutable. The chunk directory is replaced
+// wholesale when a chunk is added; readers take a snapshot of it and never
+// lock. Orderings are strictly increasing but need not be contiguous, since
+// they come from the server-wide events stream.
+//
+// With a cold store attached, full chunks older than the hot window are
+// written out and their events released; the directory keeps only the
+// ordering bounds and the store's chunk id. A read that reaches a cold chunk
+// pages it back in (through a small LRU) into the Range's own directory copy,
+// so callers iterate the same way whether events were hot or not.
+class RoomTimeline {
+public:
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    struct Chunk {
+        std::array<StreamOrdering, CHUNK_SIZE> orderings{};
+        std::array<EventPtr, CHUNK_SIZE> events;
+        std::atomic<uint32_t> count{0};
+
+        StreamOrdering first_ordering() const { return orderings[0]; }
+    };
+
+    using ChunkPtr = std::shared_ptr<Chunk>;
+
+    struct Slot {
+        ChunkPtr chunk;
+        StreamOrdering first_ordering = 0;
+        StreamOrdering last_ordering = 0;
+        uint64_t cold_id = 0;
+
+        bool is_cold() const { return chunk == nullptr; }
+    };
+
+    using Directory = std::vector<Slot>;
+
+    using TieringPolicy = TimelineTieringPolicy;
+
+    struct Position {
+        size_t chunk = 0;
+        uint32_t slot = 0;
+
+        bool operator==(const Position& other) const { return chunk == other.chunk && slot == other.slot; }
+        bool operator!=(const Position& other) const { return !(*this == other); }
+    };
+
+    // A consistent view over [begin, end) that borrows the events in place.
+    class Range {
+    public:
+        class iterator {
+        public:
+            iterator(const Directory* directory, Position position) : directory_(directory), position_(position) {}
+
+            const EventPtr& operator*() const { return (*directory_)[position_.chunk].chunk->events[position_.slot]; }
+            const EventPtr* operator->() const { return &**this; }
+            StreamOrdering ordering() const { return (*directory_)[position_.chunk].chunk->orderings[position_.slot]; }
+
+            iterator& operator++() {
+                if (++position_.slot == CHUNK_SIZE) {
+                    ++position_.chunk;
+                    position_.slot = 0;
+                }
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return position_ == other.position_; }
+            bool operator!=(const iterator& other) const { return position_ != other.position_; }
+
+        private:
+            const Directory* directory_;
+            Position position_;
+        };
+
+        Range() = default;
+        Range(std::shared_ptr<const Directory> directory, Position begin, Position end)
+            : directory_(std::move(directory)), begin_(begin), end_(end) {}
+
+        iterator begin() const { return iterator(directory_.get(), begin_); }
+        iterator end() const { return iterator(directory_.get(), end_); }
+        bool empty() const { return begin_ == end_; }
+        size_t size() const {
+            return (end_.chunk - begin_.chunk) * CHUNK_SIZE + end_.slot - begin_.slot;
+        }
+
+        std::vector<EventPtr> to_vector() const;
+        StreamOrdering last_ordering() const;
+
+    private:
+        std::shared_ptr<const Directory> directory_;
+        Position begin_;
+        Position end_;
+    };
+
+    explicit RoomTimeline(RoomHandle room = RoomHandle());
+    ~RoomTimeline() = default;
+
+    RoomTimeline(const RoomTimeline&) = delete;
+    RoomTimeline& operator=(const RoomTimeline&) = delete;
+
+    // Single writer; callers serialise appends and must also allocate the
+    // orderings under that serialisation so they arrive increasing. Room does
+    // both under its lock, see Room::add_event(event, stream). Returns false if
+    // ordering is not greater than head().
+    bool append(const EventPtr& event, StreamOrdering ordering);
+    StreamOrdering append(const EventPtr& event);
+
+    StreamOrdering head() const { return head_.load(std::memory_order_acquire); }
+    StreamOrdering first() const;
+    size_t size() const;
+
+    EventPtr at(StreamOrdering ordering) const;
+
+    Range all() const;
+    Range since(StreamOrdering after, size_t limit = 0) const;
+    Range range(StreamOrdering from, StreamOrdering to) const;
+    Range latest(size_t limit) const;
+
+    void set_cold_store(std::shared_ptr<TimelineColdStore> store, const TieringPolicy& policy = TieringPolicy());
+    // Moves full chunks beyond the hot window to the cold store; returns how
+    // many were spilled. Runs on the writer side, like append.
+    size_t spill();
+    size_t spill_to(size_t hot_events);
+    // Reattaches chunks the cold store kept from before a restart as cold
+    // slots ahead of anything already in the timeline. Chunks that are not
+    // full or that overlap existing orderings are skipped.
+    void restore_cold_chunks(const std::vector<TimelineColdStore::ChunkInfo>& chunks);
+    size_t hot_chunk_count() const;
+    size_t cold_chunk_count() const;
+
+private:
+    RoomHandle room_;
+    std::shared_ptr<const Directory> directory_;
+    std::atomic<StreamOrdering> head_{0};
+    std::mutex append_mutex_;
+
+    std::shared_ptr<TimelineColdStore> cold_store_;
+    TieringPolicy policy_;
+    mutable std::mutex page_mutex_;
+    mutable std::list<std::pair<uint64_t, ChunkPtr>> paged_in_;
+
+    std::shared_ptr<const Directory> snapshot() const { return std::atomic_load(&directory_); }
+    static Position end_of(const Directory& directory);
+    static Position seek(const Directory& directory, Position end, StreamOrdering ordering);
+
+    ChunkPtr page_in(const Slot& slot) const;
+    // Returns a copy of the directory covering [begin, end) with every cold
+    // chunk in that span loaded, rebasing begin and end to it. Returns the
+    // snapshot unchanged when the span is already hot.
+    std::shared_ptr<const Directory> materialize(std::shared_ptr<const Directory> snapshot, Position& begin, Position& end) const;
+};
+
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "../event/event.hpp"
 #include "room_state.hpp"
+#include "event_graph.hpp"
+#include "state_resolution_v2.hpp"
 #include <vector>
 #include <memory>
 #include <set>
@@ -21,6 +23,15 @@ public:
         const std::vector<EventPtr>& auth_events
     );
 
+    // Resolves through StateResolverV2 when the room's graph holds every
+    // event in the sets; the vector-based helpers below remain for callers
+    // without a graph.
+    static RoomStatePtr resolve_state(
+        const RoomID& room_id,
+        const EventGraph& graph,
+        const std::vector<std::vector<EventPtr>>& state_sets
+    );
+
     static RoomStatePtr resolve_state_events(
         const RoomID& room_id,
         const std::vector<EventPtr>& state_events
@@ -41,6 +52,11 @@ public:
         const std::vector<EventPtr>& events
     );
 
+    static std::vector<EventIndex> get_auth_chain(
+        const EventGraph& graph,
+        const std::vector<EventIndex>& events
+    );
+
     static std::vector<EventPtr> get_auth_chain_difference(
         const std::vector<EventPtr>& state_sets,
         const std::vector<EventPtr>& base_chain
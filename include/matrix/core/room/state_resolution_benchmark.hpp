@@ -0,0 +1,72 @@
+#pragma once
+
+#include "state_resolution_v2.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace matrix {
+
+struct ForkedRoomSpec {
+    size_t events = 10000;
+    size_t members = 1000;
+    // Concurrent branches kept open at any time; each merge point produces a
+    // pair of conflicting state sets for the resolver.
+    size_t forks = 8;
+    double state_event_ratio = 0.3;
+    double power_event_ratio = 0.01;
+    uint64_t seed = 1;
+};
+
+// Synthetic rooms for state resolution: a create/power/join-rules prefix, then
+// random member, name, topic and power level changes spread over forks that
+// branch and merge, so the auth difference and conflicted sets are realistic.
+class SyntheticForkedRoom : public ResolutionEventSource {
+public:
+    explicit SyntheticForkedRoom(const ForkedRoomSpec& spec);
+
+    const RoomEvent* event(EventIndex index) const override;
+
+    const EventGraph& graph() const { return *graph_; }
+    StateKeyTable& keys() { return keys_; }
+    // State sets at the heads of the forks at the final merge point.
+    const std::vector<StateSet>& fork_state_sets() const { return fork_state_sets_; }
+
+private:
+    ForkedRoomSpec spec_;
+    std::shared_ptr<EventGraph> graph_;
+    std::vector<std::shared_ptr<RoomEvent>> events_;
+    StateKeyTable keys_;
+    std::vector<StateSet> fork_state_sets_;
+
+    void generate();
+};
+
+class StateResolutionBenchmark {
+public:
+    struct BenchmarkResult {
+        std::string name;
+        size_t events;
+        size_t forks;
+        size_t conflicted_events;
+        size_t auth_difference;
+        int64_t generate_ns;
+        int64_t auth_difference_ns;
+        int64_t resolve_ns;
+        int iterations;
+    };
+
+    StateResolutionBenchmark();
+    ~StateResolutionBenchmark();
+
+    BenchmarkResult benchmark_room(const ForkedRoomSpec& spec, int iterations = 5);
+    // 10k, 100k and 1M events at the default fork count.
+    std::vector<BenchmarkResult> benchmark_corpus(int iterations = 5);
+
+    nlohmann::json get_benchmark_results() const;
+
+private:
+    std::vector<BenchmarkResult> results_;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../event/room_event.hpp"
+#include "auth_chain_index.hpp"
+#include "event_graph.hpp"
+#include "power_level_table.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace matrix {
+
+// Dense ids for (type, state_key) pairs seen during resolution, so state sets
+// can be kept as sorted integer vectors and compared by merging.
+class StateKeyTable {
+public:
+    uint32_t intern(std::string_view type, std::string_view state_key);
+    uint32_t find(std::string_view type, std::string_view state_key) const;
+    std::pair<std::string_view, std::string_view> resolve(uint32_t key) const;
+    size_t size() const { return keys_.size(); }
+
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+private:
+    std::vector<std::pair<std::string, std::string>> keys_;
+    std::unordered_map<std::string, uint32_t> index_;
+};
+
+struct StateKeyRef {
+    uint32_t key;
+    EventIndex event;
+
+    bool operator<(const StateKeyRef& other) const { return key < other.key; }
+};
+
+// Sorted by key, one entry per key.
+using StateSet = std::vector<StateKeyRef>;
+
+class ResolutionEventSource {
+public:
+    virtual ~ResolutionEventSource() = default;
+    virtual const RoomEvent* event(EventIndex index) const = 0;
+};
+
+// State resolution v2 over EventGraph indices.
+//
+//  1. Merge the sorted state sets into unconflicted state and conflicted events.
+//  2. Auth difference: one bitset per state set holding the auth chain of its
+//     events, walked on the graph's auth edges (CSR rows plus overflow);
+//     difference = union minus intersection, done word by word.
+//  3. Power events from the full conflicted set, plus their auth ancestors in
+//     it, in reverse topological power order: Kahn's algorithm over auth edges
+//     with a heap keyed on (-sender power, origin_server_ts, event_id).
+//  4. Iterative auth checks of those on top of the unconflicted state.
+//  5. Remaining events ordered by mainline position of the resolved power
+//     levels event, then ts, then event_id; iterative auth checks again; and
+//     the unconflicted state reapplied on top.
+class StateResolverV2 {
+public:
+    using AuthCheck = std::function<bool(EventIndex event, const StateSet& state)>;
+
+    struct Result {
+        StateSet state;
+        size_t conflicted_events = 0;
+        size_t auth_difference = 0;
+        size_t power_events = 0;
+        size_t rejected_events = 0;
+        int64_t time_ns = 0;
+    };
+
+    StateResolverV2(const EventGraph& graph, const ResolutionEventSource& events,
+                    StateKeyTable& keys, AuthCheck auth_check);
+
+    Result resolve(const std::vector<StateSet>& state_sets);
+
+    // With an index attached the auth difference is computed from chain
+    // ranges instead of walking the graph.
+    void set_auth_chain_index(std::shared_ptr<const AuthChainIndex> index) { auth_chains_ = std::move(index); }
+
+    static void split_conflicts(const std::vector<StateSet>& state_sets,
+                                StateSet& unconflicted, std::vector<EventIndex>& conflicted);
+    std::vector<EventIndex> auth_chain_difference(const std::vector<StateSet>& state_sets) const;
+    std::vector<EventIndex> reverse_topological_power_sort(const std::vector<EventIndex>& events) const;
+    std::vector<EventIndex> mainline_sort(const std::vector<EventIndex>& events, EventIndex power_levels_event) const;
+    StateSet iterative_auth_checks(const std::vector<EventIndex>& events, StateSet state, size_t& rejected) const;
+
+private:
+    class Bitset {
+    public:
+        explicit Bitset(size_t bits = 0) : words_((bits + 63) / 64, 0) {}
+
+        bool test(size_t bit) const { return (words_[bit >> 6] >> (bit & 63)) & 1; }
+        bool test_and_set(size_t bit) {
+            const uint64_t mask = uint64_t(1) << (bit & 63);
+            const bool was_set = (words_[bit >> 6] & mask) != 0;
+            words_[bit >> 6] |= mask;
+            return was_set;
+        }
+        std::vector<uint64_t>& words() { return words_; }
+        const std::vector<uint64_t>& words() const { return words_; }
+
+    private:
+        std::vector<uint64_t> words_;
+    };
+
+    const EventGraph& graph_;
+    const ResolutionEventSource& events_;
+    StateKeyTable& keys_;
+    AuthCheck auth_check_;
+    std::shared_ptr<const AuthChainIndex> auth_chains_;
+
+    mutable std::unordered_map<EventIndex, int> sender_power_;
+
+    Bitset auth_chain_bits(const StateSet& state_set) const;
+    bool is_power_event(EventIndex index) const;
+    int sender_power_level(EventIndex index) const;
+    EventIndex power_levels_event_in(const StateSet& state) const;
+    uint32_t key_of(EventIndex index) const;
+};
+
+}
\ No newline at end of file
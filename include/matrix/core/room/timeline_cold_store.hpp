@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../event/event.hpp"
+#include "../stream_token.hpp"
+#include "../types.hpp"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace matrix {
+
+// Backing store for timeline chunks that have left the hot window. A chunk
+// goes out as parallel ordering/event arrays and comes back the same way; the
+// returned id is opaque to the timeline.
+class TimelineColdStore {
+public:
+    struct ChunkInfo {
+        uint64_t chunk_id = 0;
+        StreamOrdering first_ordering = 0;
+        StreamOrdering last_ordering = 0;
+        uint32_t count = 0;
+    };
+
+    virtual ~TimelineColdStore() = default;
+
+    virtual std::optional<uint64_t> store_chunk(RoomHandle room, const StreamOrdering* orderings,
+                                                const EventPtr* events, size_t count) = 0;
+    virtual bool load_chunk(RoomHandle room, uint64_t chunk_id, StreamOrdering* orderings,
+                            EventPtr* events, size_t count) = 0;
+    virtual void drop_chunk(RoomHandle room, uint64_t chunk_id) = 0;
+    // Chunks still held for room, oldest first, so a timeline rebuilt after a
+    // restart can reattach them.
+    virtual std::vector<ChunkInfo> list_chunks(RoomHandle room) = 0;
+    virtual void drop_room(RoomHandle room) = 0;
+};
+
+// One append-only segment file per room under a directory, named by the
+// hex-encoded room id so it survives restarts. Each chunk is a
+// length-prefixed run of BinaryEventCodec records; the chunk id is its byte
+// offset in the segment. Next to each segment an index file logs every chunk
+// stored and dropped; it is replayed on a room's first use, so list_chunks()
+// works after a restart.
+//
+// Only max_open_segments files are kept open, in an LRU; others are closed
+// and reopened on demand. Chunk ids are offsets held by timelines, so a
+// segment is never rewritten: a dropped chunk's bytes stay until the last
+// live chunk in the segment is dropped, at which point both files are
+// deleted. drop_room() deletes them at once, and prune() removes files of
+// rooms that no longer exist, for use at startup.
+class SegmentFileColdStore : public TimelineColdStore {
+public:
+    static constexpr size_t DEFAULT_MAX_OPEN_SEGMENTS = 64;
+
+    explicit SegmentFileColdStore(const std::string& directory,
+                                  size_t max_open_segments = DEFAULT_MAX_OPEN_SEGMENTS);
+    ~SegmentFileColdStore() override;
+
+    std::optional<uint64_t> store_chunk(RoomHandle room, const StreamOrdering* orderings,
+                                        const EventPtr* events, size_t count) override;
+    bool load_chunk(RoomHandle room, uint64_t chunk_id, StreamOrdering* orderings,
+                    EventPtr* events, size_t count) override;
+    void drop_chunk(RoomHandle room, uint64_t chunk_id) override;
+    std::vector<ChunkInfo> list_chunks(RoomHandle room) override;
+    void drop_room(RoomHandle room) override;
+
+    // Deletes segments whose room fails room_exists or that hold no live
+    // chunks; returns how many rooms' files were removed.
+    size_t prune(const std::function<bool(const RoomID&)>& room_exists);
+
+private:
+    using SegmentList = std::list<std::pair<RoomHandle, std::fstream>>;
+
+    enum class IndexOp : uint8_t {
+        STORE = 1,
+        DROP = 2
+    };
+
+    std::string directory_;
+    size_t max_open_segments_;
+    std::mutex mutex_;
+    // Most recently used first.
+    SegmentList open_segments_;
+    std::unordered_map<RoomHandle, SegmentList::iterator> segments_;
+    // Live chunks per room, loaded from the index file on first use.
+    std::unordered_map<RoomHandle, std::vector<ChunkInfo>> live_chunks_;
+
+    // Opens or reuses the room's segment, closing the least recently used
+    // one when at the limit.
+    std::fstream& segment_for(RoomHandle room);
+    std::vector<ChunkInfo>& live_chunks_for(RoomHandle room);
+    void append_index(RoomHandle room, IndexOp op, const ChunkInfo& info);
+    void remove_files(RoomHandle room);
+
+    std::string segment_path(const RoomID& room_id) const;
+    std::string index_path(const RoomID& room_id) const;
+    static std::string file_stem(std::string_view room_id);
+    static std::optional<RoomID> room_id_from_stem(std::string_view stem);
+};
+
+}
\ No newline at end of file
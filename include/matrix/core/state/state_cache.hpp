@@ -2,23 +2,45 @@
 
 #include "../event/event.hpp"
 #include "../room/room_state.hpp"
+#include "../room/room_summary.hpp"
 #include "../matrix_types.hpp"
+#include "../frequency_sketch.hpp"
+#include <atomic>
 #include <unordered_map>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
 #include <list>
 
 namespace matrix {
 
+struct StateCacheConfig {
+    // Hot timeline window per room; older chunks are spilled, not dropped.
+    size_t max_events_per_room = 10000;
+    int default_ttl_seconds = 3600;
+    bool enable_compression = true;
+    // The only capacity limit, charged calculate_size() for entries of every
+    // kind. It is split evenly over the shards and each shard evicts against
+    // its own slice, so one shard may be full while others have room.
+    size_t max_bytes = 256 * 1024 * 1024;
+    size_t shard_count = 16;
+    // Share of each shard's budget given to the admission window.
+    double window_ratio = 0.01;
+};
+
+// Room-keyed cache split into shards by room handle. Each shard runs
+// W-TinyLFU against its share of the byte budget: new entries land in a small
+// LRU window, and when the window overflows its victim is only admitted to the
+// main segmented LRU if the frequency sketch rates it above the main
+// segment's own victim. A scan over many cold rooms therefore churns the
+// window instead of evicting hot rooms.
+//
+// An entry larger than the window skips it and goes straight to the sketch
+// comparison against probation. One larger than the shard's whole slice is
+// still admitted: it evicts everything else in its shard and stays until it
+// is replaced, so a single big room is cached rather than refused.
 class StateCache {
 public:
-    struct CacheConfig {
-        size_t max_room_states = 1000;
-        size_t max_events_per_room = 10000;
-        size_t max_auth_chains = 500;
-        int default_ttl_seconds = 3600;
-        bool enable_compression = true;
-    };
+    using CacheConfig = StateCacheConfig;
 
     StateCache(const CacheConfig& config = CacheConfig());
     ~StateCache() = default;
@@ -44,8 +66,8 @@ public:
     std::vector<UserID> get_room_members(const RoomID& room_id, Membership membership) const;
     bool has_room_members(const RoomID& room_id, Membership membership) const;
 
-    bool store_room_summary(const RoomID& room_id, const nlohmann::json& summary, int ttl_seconds = -1);
-    nlohmann::json get_room_summary(const RoomID& room_id) const;
+    bool store_room_summary(const RoomID& room_id, const RoomSummaryPtr& summary, int ttl_seconds = -1);
+    RoomSummaryPtr get_room_summary(const RoomID& room_id) const;
     bool has_room_summary(const RoomID& room_id) const;
 
     void set_room_state_ttl(const RoomID& room_id, int ttl_seconds);
@@ -57,6 +79,7 @@ public:
     size_t get_room_state_count() const;
     size_t get_auth_chain_count() const;
     size_t get_total_cached_items() const;
+    size_t get_total_bytes() const;
 
     nlohmann::json get_cache_stats() const;
 
@@ -66,47 +89,98 @@ public:
     void cleanup_expired();
     void cleanup_lru();
 
-    void resize(size_t max_room_states, size_t max_events_per_room);
+    // Capacity is bytes, not entry counts; see StateCacheConfig::max_bytes.
+    void set_max_bytes(size_t max_bytes);
+    void set_max_events_per_room(size_t max_events_per_room);
 
 private:
+    enum class EntryKind : uint8_t {
+        ROOM_STATE,
+        AUTH_CHAIN,
+        POWER_LEVELS,
+        ROOM_MEMBERS,
+        ROOM_SUMMARY
+    };
+
+    enum class Segment : uint8_t {
+        WINDOW,
+        PROBATION,
+        PROTECTED
+    };
+
+    struct EntryKey {
+        RoomHandle room;
+        EntryKind kind;
+        uint8_t variant = 0;
+
+        bool operator==(const EntryKey& other) const {
+            return room == other.room && kind == other.kind && variant == other.variant;
+        }
+        uint64_t hash() const {
+            return (static_cast<uint64_t>(room.handle()) << 16) | (static_cast<uint64_t>(kind) << 8) | variant;
+        }
+    };
+
+    struct EntryKeyHash {
+        size_t operator()(const EntryKey& key) const { return std::hash<uint64_t>{}(key.hash()); }
+    };
+
     struct CacheEntry {
         std::shared_ptr<void> data;
         Timestamp created_ts;
         Timestamp expires_ts;
         Timestamp last_accessed;
         size_t size;
+        Segment segment = Segment::WINDOW;
+        std::list<EntryKey>::iterator position;
+    };
+
+    using EntryMap = std::unordered_map<EntryKey, CacheEntry, EntryKeyHash>;
+
+    struct ShardStats {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> evictions{0};
+        std::atomic<uint64_t> admissions{0};
+        std::atomic<uint64_t> rejections{0};
     };
 
-    struct RoomStateCache {
-        RoomStatePtr state;
-        std::unordered_map<std::string, EventPtr> state_events;
-        std::unordered_map<std::string, std::vector<EventPtr>> events_by_type;
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        EntryMap entries;
+        std::list<EntryKey> window;
+        std::list<EntryKey> probation;
+        std::list<EntryKey> protected_;
+        size_t window_bytes = 0;
+        size_t probation_bytes = 0;
+        size_t protected_bytes = 0;
+        size_t window_budget = 0;
+        size_t main_budget = 0;
+        mutable FrequencySketch sketch;
+        mutable ShardStats stats;
     };
 
-    mutable std::shared_mutex mutex_;
     CacheConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
-    std::unordered_map<RoomID, CacheEntry> room_states_;
-    std::unordered_map<RoomID, CacheEntry> auth_chains_;
-    std::unordered_map<RoomID, CacheEntry> power_levels_;
-    std::unordered_map<RoomID, std::unordered_map<Membership, CacheEntry>> room_members_;
-    std::unordered_map<RoomID, CacheEntry> room_summaries_;
-
-    std::list<RoomID> room_state_lru_;
-    std::list<RoomID> auth_chain_lru_;
+    Shard& shard_for(RoomHandle room) const { return *shards_[room.handle() % shards_.size()]; }
 
     template<typename T>
-    bool store_in_cache(std::unordered_map<RoomID, CacheEntry>& cache,
-                       const RoomID& room_id,
-                       const T& data,
-                       int ttl_seconds);
+    bool store_in_cache(EntryKey key, const T& data, size_t size, int ttl_seconds);
 
     template<typename T>
-    std::shared_ptr<T> get_from_cache(const std::unordered_map<RoomID, CacheEntry>& cache,
-                                     const RoomID& room_id) const;
+    std::shared_ptr<T> get_from_cache(EntryKey key) const;
+
+    bool has_in_cache(EntryKey key) const;
+    bool remove_from_cache(EntryKey key);
 
-    void update_lru(std::list<RoomID>& lru_list, const RoomID& room_id);
-    void evict_lru(std::unordered_map<RoomID, CacheEntry>& cache, std::list<RoomID>& lru_list);
+    // Moves a hit entry toward the protected segment; called under the shard lock.
+    void on_access(Shard& shard, CacheEntry& entry) const;
+    void evict_window(Shard& shard);
+    // Evicts until the main segments fit main_budget, or until only the
+    // entry being admitted is left when it alone exceeds the budget.
+    void evict_main(Shard& shard);
+    void remove_entry(Shard& shard, EntryMap::iterator it);
 
     bool is_expired(const CacheEntry& entry) const;
     int calculate_ttl(int ttl_seconds) const;
@@ -115,7 +189,9 @@ private:
     size_t calculate_size(const PowerLevels& levels) const;
     size_t calculate_size(const std::vector<UserID>& members) const;
     size_t calculate_size(const nlohmann::json& data) const;
+    size_t calculate_size(const RoomSummary& summary) const;
 
+    void configure_shards();
     void compress_cache();
 };
 
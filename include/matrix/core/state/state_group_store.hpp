@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../persistent_map.hpp"
+#include "../types.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+using StateGroupId = int64_t;
+
+struct StateEntry {
+    std::string type;
+    std::string state_key;
+    // Empty when the delta removes the key.
+    EventID event_id;
+};
+
+using StateDelta = std::vector<StateEntry>;
+using StateIdMap = PersistentMap<PersistentMap<EventID>>;
+
+struct ResolvedStateGroup {
+    StateGroupId group = 0;
+    RoomHandle room;
+    StateIdMap state;
+    size_t size = 0;
+
+    const EventID* find(std::string_view type, std::string_view state_key) const {
+        const auto* keys = state.find(type);
+        return keys != nullptr ? keys->find(state_key) : nullptr;
+    }
+};
+
+using ResolvedStateGroupPtr = std::shared_ptr<const ResolvedStateGroup>;
+
+// Persistence for state groups; rows map onto federation_state_groups,
+// federation_state_group_edges, federation_state_group_state and
+// event_to_state_groups. chain_length is stored with the edge so a group
+// read back after eviction or a restart still knows how far it is from its
+// snapshot; 0 marks a snapshot.
+class StateGroupBackend {
+public:
+    struct GroupRecord {
+        StateGroupId group = 0;
+        RoomID room_id;
+        EventID event_id;
+        std::optional<StateGroupId> prev_group;
+        uint32_t chain_length = 0;
+        StateDelta delta;
+    };
+
+    virtual ~StateGroupBackend() = default;
+
+    virtual bool store_group(const GroupRecord& record) = 0;
+    virtual std::optional<GroupRecord> load_group(StateGroupId group) = 0;
+    virtual bool store_event_group(const EventID& event_id, StateGroupId group) = 0;
+    virtual std::optional<StateGroupId> load_event_group(const EventID& event_id) = 0;
+    virtual StateGroupId max_group_id() = 0;
+};
+
+struct StateGroupStoreConfig {
+    size_t max_chain_length = 50;
+    size_t resolved_cache_size = 2048;
+    size_t event_cache_size = 100000;
+    size_t group_cache_size = 100000;
+};
+
+// State at each event stored as a delta against a parent group. Chains are
+// cut at max_chain_length by writing a full snapshot instead of a delta, so
+// resolving a cold group reads at most that many rows. Resolved groups are
+// kept in an LRU; a child of a cached group is resolved by applying its one
+// delta to the parent's PersistentMap, which shares everything else. The
+// event -> group and group -> parent maps are LRUs bounded by
+// event_cache_size and group_cache_size; evicted entries are re-read from the
+// backend.
+class StateGroupStore {
+public:
+    using Config = StateGroupStoreConfig;
+
+    struct Stats {
+        size_t groups_created = 0;
+        size_t snapshots_created = 0;
+        size_t cache_hits = 0;
+        size_t cache_misses = 0;
+        size_t deltas_applied = 0;
+    };
+
+    explicit StateGroupStore(std::shared_ptr<StateGroupBackend> backend, const Config& config = Config());
+
+    // Records the state after event_id. An empty delta reuses prev_group.
+    StateGroupId store_state(const RoomID& room_id, const EventID& event_id,
+                             std::optional<StateGroupId> prev_group, const StateDelta& delta);
+    StateGroupId store_full_state(const RoomID& room_id, const EventID& event_id, const StateIdMap& state);
+
+    std::optional<StateGroupId> state_group_for_event(const EventID& event_id);
+    ResolvedStateGroupPtr resolve(StateGroupId group);
+    ResolvedStateGroupPtr state_at_event(const EventID& event_id);
+
+    // Delta between two groups, used for incremental sync state blocks.
+    StateDelta diff(StateGroupId from, StateGroupId to);
+
+    Stats stats() const;
+    void clear_cache();
+
+private:
+    struct GroupInfo {
+        RoomHandle room;
+        std::optional<StateGroupId> prev_group;
+        uint32_t chain_length = 0;
+    };
+
+    std::shared_ptr<StateGroupBackend> backend_;
+    Config config_;
+
+    mutable std::mutex mutex_;
+    StateGroupId next_group_ = 0;
+    using GroupInfoList = std::list<std::pair<StateGroupId, GroupInfo>>;
+    using EventGroupList = std::list<std::pair<EventHandle, StateGroupId>>;
+
+    GroupInfoList group_lru_;
+    std::unordered_map<StateGroupId, GroupInfoList::iterator> groups_;
+    EventGroupList event_group_lru_;
+    std::unordered_map<EventHandle, EventGroupList::iterator> event_groups_;
+
+    std::list<ResolvedStateGroupPtr> resolved_lru_;
+    std::unordered_map<StateGroupId, std::list<ResolvedStateGroupPtr>::iterator> resolved_;
+    Stats stats_;
+
+    StateGroupId allocate_group();
+    // Falls back to backend_->load_group() and takes chain_length from the
+    // record, so cut-offs stay at max_chain_length across evictions.
+    std::optional<GroupInfo> group_info(StateGroupId group);
+    void remember_group(StateGroupId group, const GroupInfo& info);
+    void remember_event_group(EventHandle event, StateGroupId group);
+    ResolvedStateGroupPtr cached(StateGroupId group);
+    void cache(const ResolvedStateGroupPtr& resolved);
+    static void apply_delta(ResolvedStateGroup& target, const StateDelta& delta);
+};
+
+}
\ No newline at end of file
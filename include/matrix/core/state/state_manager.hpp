@@ -2,6 +2,10 @@
 
 #include "../event/event.hpp"
 #include "../room/room_state.hpp"
+#include "../room/room_summary.hpp"
+#include "state_group_store.hpp"
+#include "state_resolution_scheduler.hpp"
+#include "../room/auth_chain_index.hpp"
 #include "../matrix_types.hpp"
 #include <unordered_map>
 #include <memory>
@@ -34,6 +38,7 @@ public:
     bool is_user_banned(const RoomID& room_id, const UserID& user_id) const;
 
     PowerLevels get_power_levels(const RoomID& room_id) const;
+    PowerLevelTablePtr get_power_table(const RoomID& room_id) const;
     int get_user_power_level(const RoomID& room_id, const UserID& user_id) const;
     int get_event_power_level(const RoomID& room_id, const std::string& event_type) const;
 
@@ -56,11 +61,22 @@ public:
 
     RoomStatePtr resolve_state(const RoomID& room_id, const std::vector<EventPtr>& state_events);
     RoomStatePtr resolve_state_conflict(const RoomID& room_id, const std::vector<EventPtr>& conflicted_events, const std::vector<EventPtr>& auth_events);
+    StateResolutionScheduler::Future resolve_state_async(const RoomID& room_id, StateResolutionScheduler::StateSets state_sets);
+    std::vector<RoomStateSnapshot> resolve_states(std::vector<StateResolutionScheduler::Request> requests);
+    StateResolutionScheduler::Stats get_resolution_stats() const;
 
     std::vector<EventPtr> get_auth_chain(const RoomID& room_id, const std::vector<EventPtr>& events);
     std::vector<EventPtr> get_auth_chain_difference(const RoomID& room_id, const std::vector<EventPtr>& state_sets);
 
-    nlohmann::json get_room_summary(const RoomID& room_id) const;
+    RoomSummaryPtr get_room_summary(const RoomID& room_id) const;
+
+    void set_state_group_store(std::shared_ptr<StateGroupStore> store) { state_groups_ = std::move(store); }
+    std::shared_ptr<StateGroupStore> state_group_store() const { return state_groups_; }
+    ResolvedStateGroupPtr get_state_at_event(const EventID& event_id) const;
+
+    void set_auth_chain_store(std::shared_ptr<AuthChainStore> store) { auth_chain_store_ = std::move(store); }
+    // Loaded from the store on first use for the room.
+    std::shared_ptr<AuthChainIndex> get_auth_chain_index(const RoomID& room_id);
     nlohmann::json get_room_state_snapshot(const RoomID& room_id) const;
 
     void clear_room_state(const RoomID& room_id);
@@ -73,12 +89,16 @@ public:
 
 private:
     mutable std::shared_mutex mutex_;
-    std::unordered_map<RoomID, RoomStatePtr> room_states_;
-    std::unordered_map<RoomID, std::vector<EventPtr>> room_auth_chains_;
-
-    RoomStatePtr get_or_create_room_state(const RoomID& room_id);
-    void update_auth_chain(const RoomID& room_id, const EventPtr& event);
-    std::vector<EventPtr> calculate_auth_chain(const std::vector<EventPtr>& events) const;
+    std::unordered_map<RoomHandle, RoomStatePtr> room_states_;
+    std::unordered_map<RoomHandle, std::shared_ptr<AuthChainIndex>> auth_chain_indexes_;
+    std::shared_ptr<AuthChainStore> auth_chain_store_;
+    std::unique_ptr<StateResolutionScheduler> scheduler_;
+    std::shared_ptr<StateGroupStore> state_groups_;
+
+    RoomStatePtr get_or_create_room_state(RoomHandle room);
+    RoomStatePtr find_room_state(RoomHandle room) const;
+    void update_auth_chain(RoomHandle room, const EventPtr& event);
+    void persist_auth_chain(RoomHandle room, AuthChainIndex& index);
 
     bool validate_state_event(const EventPtr& event) const;
     bool is_power_event(const EventPtr& event) const;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../event/event.hpp"
+#include "../room/room_state.hpp"
+#include "../worker_pool.hpp"
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix {
+
+struct StateResolutionSchedulerConfig {
+    size_t memo_capacity = 4096;
+};
+
+// Runs state resolutions on the worker pool. Requests are keyed by room plus
+// the state sets with event ids sorted inside each set and the sets sorted:
+// a request matching one in flight shares its future instead of running
+// again, and a finished result is memoized in an LRU under the same key.
+// The canonical key is kept next to its hash and compared on every hit.
+// Results are shared by every coalesced caller and the memo, so they are
+// only handed out const; a caller that wants to apply events on top takes
+// copy() first. The resolver must return a state nobody else holds.
+class StateResolutionScheduler {
+public:
+    using Config = StateResolutionSchedulerConfig;
+    using StateSets = std::vector<std::vector<EventPtr>>;
+    using Resolver = std::function<RoomStatePtr(const RoomID& room_id, const StateSets& state_sets)>;
+    using Future = std::shared_future<RoomStateSnapshot>;
+
+    struct Request {
+        RoomID room_id;
+        StateSets state_sets;
+    };
+
+    struct Stats {
+        size_t submitted = 0;
+        size_t executed = 0;
+        size_t coalesced = 0;
+        size_t memo_hits = 0;
+    };
+
+    StateResolutionScheduler(Resolver resolver, WorkerPool& pool = WorkerPool::shared(),
+                             const Config& config = Config());
+    ~StateResolutionScheduler();
+
+    Future submit(const RoomID& room_id, StateSets state_sets);
+    // Submits everything first so independent rooms resolve concurrently,
+    // then waits, helping the pool while it does.
+    std::vector<RoomStateSnapshot> resolve_all(std::vector<Request> requests);
+    RoomStateSnapshot resolve(const RoomID& room_id, StateSets state_sets);
+
+    Stats stats() const;
+    void clear_memo();
+
+private:
+    struct Key {
+        uint64_t hash = 0;
+        RoomHandle room;
+        // Event handles of each sorted set, sets separated by 0.
+        std::vector<uint32_t> canonical;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && room == other.room && canonical == other.canonical;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+    };
+
+    using MemoList = std::list<std::pair<Key, RoomStateSnapshot>>;
+
+    Resolver resolver_;
+    WorkerPool& pool_;
+    Config config_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Future, KeyHash> in_flight_;
+    MemoList memo_lru_;
+    std::unordered_map<Key, MemoList::iterator, KeyHash> memo_;
+    Stats stats_;
+
+    static Key make_key(const RoomID& room_id, const StateSets& state_sets);
+    void finish(const Key& key, const RoomStateSnapshot& result);
+};
+
+}
\ No newline at end of file
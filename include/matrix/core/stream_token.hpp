@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace matrix {
+
+using StreamOrdering = int64_t;
+
+enum class StreamId : uint8_t {
+    EVENTS,
+    TO_DEVICE,
+    ACCOUNT_DATA,
+    PRESENCE,
+    RECEIPTS,
+    TYPING,
+    DEVICE_LISTS,
+    COUNT
+};
+
+inline constexpr size_t STREAM_COUNT = static_cast<size_t>(StreamId::COUNT);
+
+// Position in every stream at once, used for sync next_batch / since and for
+// pagination from/to. Encoded as "s" followed by one base-36 field per stream
+// separated by '_', with trailing zero fields dropped, e.g. "s2bx_4_0_k1".
+class StreamToken {
+public:
+    static constexpr size_t MAX_ENCODED_LENGTH = 1 + STREAM_COUNT * 14;
+
+    StreamToken() = default;
+
+    StreamOrdering get(StreamId stream) const { return positions_[static_cast<size_t>(stream)]; }
+    void set(StreamId stream, StreamOrdering position) { positions_[static_cast<size_t>(stream)] = position; }
+
+    StreamOrdering events() const { return get(StreamId::EVENTS); }
+
+    bool is_newer(StreamId stream, StreamOrdering position) const { return position > get(stream); }
+    bool is_after(const StreamToken& other) const;
+
+    // Component-wise max; sync merges a client token with the current one.
+    StreamToken& advance(const StreamToken& other);
+
+    std::string encode() const;
+    size_t encode_into(char* out) const;
+    static std::optional<StreamToken> decode(std::string_view token);
+
+    bool operator==(const StreamToken& other) const { return positions_ == other.positions_; }
+    bool operator!=(const StreamToken& other) const { return positions_ != other.positions_; }
+
+private:
+    std::array<StreamOrdering, STREAM_COUNT> positions_{};
+};
+
+// Monotonic position source for one stream. Positions are handed out in
+// order but may complete in any order. Completion is recorded lock-free in a
+// ring of WINDOW slots: completing p stores p into slot p % WINDOW, and
+// whoever finds the slot after current() filled advances current() with a
+// CAS, repeating while the next slot is filled too. current() is therefore
+// one below the lowest position still outstanding, never ahead of data a
+// reader cannot see yet. next() waits while WINDOW positions are in flight,
+// which keeps a slot from being reused before its position completes.
+class StreamIdGenerator {
+public:
+    static constexpr size_t WINDOW = 4096;
+
+    explicit StreamIdGenerator(StreamOrdering start = 0) : next_(start + 1), current_(start) {}
+
+    // Every position returned must be passed to complete(), including when
+    // the write it was reserved for fails. A thread completes its position
+    // before asking for another; holding one across next() can wait on itself.
+    StreamOrdering next() {
+        const StreamOrdering position = next_.fetch_add(1, std::memory_order_relaxed);
+        while (position - current_.load(std::memory_order_acquire) > static_cast<StreamOrdering>(WINDOW)) {
+            std::this_thread::yield();
+        }
+        return position;
+    }
+
+    void complete(StreamOrdering position) {
+        slot(position).store(position);
+        StreamOrdering current = current_.load();
+        while (slot(current + 1).load() == current + 1) {
+            if (current_.compare_exchange_weak(current, current + 1)) {
+                ++current;
+            }
+        }
+    }
+
+    StreamOrdering current() const { return current_.load(std::memory_order_acquire); }
+
+    // Used at startup, before any next(), to continue from the highest
+    // position in storage.
+    void advance_to(StreamOrdering position) {
+        if (position >= next_.load()) {
+            next_.store(position + 1);
+            current_.store(position);
+        }
+    }
+
+private:
+    std::atomic<StreamOrdering> next_;
+    std::atomic<StreamOrdering> current_;
+    std::array<std::atomic<StreamOrdering>, WINDOW> completed_{};
+
+    std::atomic<StreamOrdering>& slot(StreamOrdering position) {
+        return completed_[static_cast<size_t>(position) % WINDOW];
+    }
+};
+
+class StreamIdGenerators {
+public:
+    StreamIdGenerators() = default;
+
+    static StreamIdGenerators& shared();
+
+    StreamIdGenerator& operator[](StreamId stream) { return generators_[static_cast<size_t>(stream)]; }
+    const StreamIdGenerator& operator[](StreamId stream) const { return generators_[static_cast<size_t>(stream)]; }
+
+    StreamToken current_token() const;
+
+private:
+    std::array<StreamIdGenerator, STREAM_COUNT> generators_;
+};
+
+}
\ No newline at end of file
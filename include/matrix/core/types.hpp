@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <chrono>
+#include "interned_id.hpp"
 
 namespace matrix {
 
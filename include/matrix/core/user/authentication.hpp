@@ -90,15 +90,15 @@ private:
 
     struct AccessToken {
         std::string token;
-        UserID user_id;
-        DeviceID device_id;
+        UserHandle user_id;
+        DeviceHandle device_id;
         Timestamp created_ts;
         Timestamp expires_ts;
         bool valid = true;
     };
 
     struct UserCredentials {
-        std::string user_id;
+        UserHandle user_id;
         std::string password_hash;
         std::string salt;
         std::string algorithm;
@@ -107,8 +107,8 @@ private:
 
     mutable std::shared_mutex mutex_;
     std::unordered_map<std::string, AccessToken> access_tokens_;
-    std::unordered_map<UserID, std::vector<std::string>> user_tokens_;
-    std::unordered_map<std::string, UserCredentials> user_credentials_;
+    std::unordered_map<UserHandle, std::vector<std::string>> user_tokens_;
+    std::unordered_map<UserHandle, UserCredentials> user_credentials_;
     std::unordered_map<std::string, AuthSession> auth_sessions_;
 
     std::string generate_access_token() const;
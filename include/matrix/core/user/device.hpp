@@ -11,8 +11,10 @@ public:
     Device(const UserID& user_id, const DeviceID& device_id);
     ~Device() = default;
 
-    UserID user_id() const { return user_id_; }
-    DeviceID device_id() const { return device_id_; }
+    const UserID& user_id() const { return user_id_.str(); }
+    const DeviceID& device_id() const { return device_id_.str(); }
+    UserHandle user_handle() const { return user_id_; }
+    DeviceHandle device_handle() const { return device_id_; }
     std::string display_name() const { return display_name_; }
     int64_t last_seen_ts() const { return last_seen_ts_; }
     std::string ip() const { return ip_; }
@@ -58,8 +60,8 @@ public:
     bool validate_keys() const;
 
 private:
-    UserID user_id_;
-    DeviceID device_id_;
+    UserHandle user_id_;
+    DeviceHandle device_id_;
     std::string display_name_;
     int64_t last_seen_ts_ = 0;
     std::string ip_;
@@ -12,7 +12,8 @@ public:
     User(const UserID& user_id);
     ~User() = default;
 
-    UserID user_id() const { return user_id_; }
+    const UserID& user_id() const { return user_id_.str(); }
+    UserHandle user_handle() const { return user_id_; }
     std::string display_name() const { return display_name_; }
     std::string avatar_url() const { return avatar_url_; }
     bool is_admin() const { return is_admin_; }
@@ -56,7 +57,7 @@ public:
     bool validate() const;
 
 private:
-    UserID user_id_;
+    UserHandle user_id_;
     std::string display_name_;
     std::string avatar_url_;
     bool is_admin_ = false;
@@ -70,8 +71,8 @@ private:
     int last_active_ago_ = 0;
     bool currently_active_ = false;
 
-    std::vector<DeviceID> devices_;
-    std::unordered_map<RoomID, Membership> room_memberships_;
+    std::vector<DeviceHandle> devices_;
+    std::unordered_map<RoomHandle, Membership> room_memberships_;
 };
 
 using UserPtr = std::shared_ptr<User>;
@@ -3,6 +3,7 @@
 #include "user.hpp"
 #include "device.hpp"
 #include "../matrix_types.hpp"
+#include "../room/membership_index.hpp"
 #include <unordered_map>
 #include <memory>
 #include <shared_mutex>
@@ -11,7 +12,7 @@ namespace matrix {
 
 class UserManager {
 public:
-    UserManager();
+    explicit UserManager(MembershipIndex& memberships = MembershipIndex::shared());
     ~UserManager() = default;
 
     UserPtr create_user(const UserID& user_id, const std::string& display_name = "");
@@ -58,13 +59,12 @@ public:
 
 private:
     mutable std::shared_mutex mutex_;
-    std::unordered_map<UserID, UserPtr> users_;
-    std::unordered_map<UserID, std::unordered_map<DeviceID, DevicePtr>> user_devices_;
-    std::unordered_map<RoomID, std::unordered_map<UserID, Membership>> room_users_;
+    std::unordered_map<UserHandle, UserPtr> users_;
+    std::unordered_map<UserHandle, std::unordered_map<DeviceHandle, DevicePtr>> user_devices_;
+    MembershipIndex& memberships_;
 
-    UserPtr create_user_internal(const UserID& user_id);
-    void update_user_room_membership(const UserID& user_id, const RoomID& room_id, Membership membership);
-    void remove_user_room_membership(const UserID& user_id, const RoomID& room_id);
+    UserPtr create_user_internal(UserHandle user);
+    UserPtr find_user(UserHandle user) const;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace matrix {
+
+// Work-stealing pool. Each worker owns a deque: tasks it submits go on its
+// own back and it pops from the back, so nested work stays hot in cache;
+// idle workers steal from the front of the others. Submissions from outside
+// the pool are spread round-robin over the deques.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t thread_count = std::thread::hardware_concurrency());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    static WorkerPool& shared();
+
+    size_t thread_count() const { return threads_.size(); }
+
+    void submit(std::function<void()> task);
+
+    // Splits [0, count) into contiguous ranges of at least min_chunk items and
+    // runs them on the pool; the calling thread takes a share and the call
+    // returns once every range is done.
+    void parallel_for(size_t count, size_t min_chunk, const std::function<void(size_t begin, size_t end)>& fn);
+
+    // Runs queued tasks on the calling thread until done() is true, so a
+    // worker waiting on a result it depends on cannot starve the pool.
+    void help_until(const std::function<bool()>& done);
+
+    bool in_worker_thread() const { return current_pool_ == this; }
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> pending_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> stopping_{false};
+
+    static thread_local WorkerPool* current_pool_;
+    static thread_local size_t current_index_;
+
+    bool pop_local(size_t index, std::function<void()>& task);
+    bool steal(size_t thief, std::function<void()>& task);
+    bool try_run_one(size_t index);
+    void worker_loop(size_t index);
+};
+
+}
\ No newline at end of file
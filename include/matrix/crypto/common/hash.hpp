@@ -2,6 +2,7 @@
 
 #include "crypto_types.hpp"
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace matrix::crypto {
@@ -70,7 +71,8 @@ public:
 
     bool initialize();
     bool update(const std::vector<uint8_t>& data);
-    bool update(const std::string& data);
+    bool update(const uint8_t* data, size_t size);
+    bool update(std::string_view data);
     CryptoResult<HashResult> finalize();
     bool reset();
 
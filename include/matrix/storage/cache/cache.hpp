@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../core/matrix_types.hpp"
+#include "../../core/event/event.hpp"
 #include <memory>
 #include <string>
 #include <functional>
@@ -23,6 +24,9 @@ public:
     virtual bool set_binary(const std::string& key, const std::vector<uint8_t>& value, int ttl_seconds = 0);
     virtual std::vector<uint8_t> get_binary(const std::string& key);
 
+    virtual bool set_event(const std::string& key, const core::Event& event, int ttl_seconds = 0);
+    virtual std::shared_ptr<core::Event> get_event(const std::string& key);
+
     virtual int64_t get_size() const = 0;
     virtual int64_t get_max_size() const = 0;
     virtual int64_t get_item_count() const = 0;
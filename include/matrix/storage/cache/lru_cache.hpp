@@ -64,6 +64,9 @@ public:
     bool remove(const std::string& key) override;
     bool clear() override;
 
+    bool set_binary(const std::string& key, const std::vector<uint8_t>& value, int ttl_seconds = 0) override;
+    std::vector<uint8_t> get_binary(const std::string& key) override;
+
     int64_t get_size() const override;
     int64_t get_max_size() const override;
     int64_t get_item_count() const override;
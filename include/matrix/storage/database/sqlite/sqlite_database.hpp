@@ -84,6 +84,9 @@ public:
     std::vector<std::unique_ptr<core::Event>> read_events_by_reference(const core::EventID& event_id, const std::string& relation_type = "") override;
 
     bool create_batch(const std::vector<core::Event>& events) override;
+    bool create_encoded(const core::Event& event) override;
+    std::unique_ptr<core::Event> read_encoded(const core::EventID& event_id) override;
+    std::vector<std::unique_ptr<core::Event>> read_encoded_by_room_id(const core::RoomID& room_id, int limit = 100, const std::string& since_token = "") override;
     bool update_unsigned_data(const core::EventID& event_id, const core::UnsignedData& unsigned_data) override;
     bool add_relation(const core::EventID& from_event, const core::EventID& to_event, const std::string& relation_type) override;
     bool remove_relations(const core::EventID& event_id) override;
@@ -94,6 +97,11 @@ public:
 
     int64_t get_room_event_count(const core::RoomID& room_id) override;
     int64_t get_event_depth(const core::EventID& event_id) override;
+    std::vector<EventEdges> read_room_event_edges(const core::RoomID& room_id, int64_t min_depth = 0) override;
+    bool read_auth_chain_index(const core::RoomID& room_id, std::vector<core::AuthChainIndex::Row>& rows,
+                               std::vector<core::AuthChainIndex::Link>& links) override;
+    bool store_auth_chain_index(const core::RoomID& room_id, const std::vector<core::AuthChainIndex::Row>& rows,
+                                const std::vector<core::AuthChainIndex::Link>& links) override;
     std::string get_latest_event_id_for_room(const core::RoomID& room_id) override;
 
     bool delete_events_for_room(const core::RoomID& room_id) override;
@@ -106,6 +114,7 @@ private:
     std::shared_ptr<ConnectionPool> connection_pool_;
 
     core::Event parse_event_from_row(const std::vector<std::string>& row) const;
+    std::vector<core::Event> parse_event_rows(const std::vector<std::vector<std::string>>& rows) const;
     std::vector<std::string> serialize_event_for_insert(const core::Event& event) const;
     std::string build_event_search_query(const EventFilter& filter) const;
 };
@@ -170,6 +179,12 @@ public:
     std::unique_ptr<RoomSummary> get_room_summary(const core::RoomID& room_id) override;
     std::vector<RoomSummary> get_public_room_summaries(int limit = 100, const std::string& since_token = "") override;
 
+    bool store_state_group(const core::StateGroupBackend::GroupRecord& record) override;
+    std::optional<core::StateGroupBackend::GroupRecord> read_state_group(core::StateGroupId group) override;
+    bool store_event_state_group(const core::EventID& event_id, core::StateGroupId group) override;
+    std::optional<core::StateGroupId> read_event_state_group(const core::EventID& event_id) override;
+    core::StateGroupId get_max_state_group() override;
+
 private:
     std::shared_ptr<ConnectionPool> connection_pool_;
 
@@ -29,6 +29,9 @@ private:
     static Migration create_media_repository_migration();
     static Migration create_optimization_indexes_migration();
     static Migration create_advanced_features_migration();
+    static Migration create_event_encoding_migration();
+    static Migration create_state_groups_migration();
+    static Migration create_event_auth_chains_migration();
 };
 
 class MigrationSQL {
@@ -50,6 +53,9 @@ public:
     static const std::string CREATE_EVENT_RELATIONS_TABLE;
     static const std::string CREATE_EVENT_EDGES_TABLE;
     static const std::string CREATE_EVENT_AUTH_CHAIN_TABLE;
+    static const std::string CREATE_EVENT_AUTH_CHAIN_LINKS_TABLE;
+    static const std::string ADD_EVENTS_ENCODED_COLUMN;
+    static const std::string CREATE_EVENT_TO_STATE_GROUPS_TABLE;
     static const std::string CREATE_FEDERATION_QUEUES_TABLE;
     static const std::string CREATE_FEDERATION_PDU_ORIGIN_TABLE;
     static const std::string CREATE_FEDERATION_TRANSACTIONS_TABLE;
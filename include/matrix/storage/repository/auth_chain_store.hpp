@@ -0,0 +1,29 @@
+#pragma once
+
+#include "event_repository.hpp"
+#include "../../core/room/auth_chain_index.hpp"
+#include <memory>
+
+namespace matrix::storage::repository {
+
+class EventRepositoryAuthChainStore : public core::AuthChainStore {
+public:
+    explicit EventRepositoryAuthChainStore(std::shared_ptr<EventRepository> repository)
+        : repository_(std::move(repository)) {}
+    ~EventRepositoryAuthChainStore() override = default;
+
+    bool load_room(const core::RoomID& room_id, std::vector<core::AuthChainIndex::Row>& rows,
+                   std::vector<core::AuthChainIndex::Link>& links) override {
+        return repository_->read_auth_chain_index(room_id, rows, links);
+    }
+
+    bool store(const core::RoomID& room_id, const std::vector<core::AuthChainIndex::Row>& rows,
+               const std::vector<core::AuthChainIndex::Link>& links) override {
+        return repository_->store_auth_chain_index(room_id, rows, links);
+    }
+
+private:
+    std::shared_ptr<EventRepository> repository_;
+};
+
+}
\ No newline at end of file
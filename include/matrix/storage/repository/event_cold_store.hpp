@@ -0,0 +1,52 @@
+#pragma once
+
+#include "event_repository.hpp"
+#include "../../core/room/timeline_cold_store.hpp"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace matrix::storage::repository {
+
+// Spills timeline chunks into the events table. Events are written with
+// create_encoded if they are not there yet; only the event ids of each chunk
+// are kept in memory and load_chunk reads them back with read_encoded. Rows
+// written earlier through the JSON create() path have no encoded column, so
+// those are read back as JSON instead.
+class EventRepositoryColdStore : public core::TimelineColdStore {
+public:
+    explicit EventRepositoryColdStore(std::shared_ptr<EventRepository> repository);
+    ~EventRepositoryColdStore() override = default;
+
+    std::optional<uint64_t> store_chunk(core::RoomHandle room, const core::StreamOrdering* orderings,
+                                        const core::EventPtr* events, size_t count) override;
+    bool load_chunk(core::RoomHandle room, uint64_t chunk_id, core::StreamOrdering* orderings,
+                    core::EventPtr* events, size_t count) override;
+    void drop_chunk(core::RoomHandle room, uint64_t chunk_id) override;
+    // Chunk ids are not persisted; after a restart this is empty and the
+    // timeline is rebuilt from the events table instead.
+    std::vector<ChunkInfo> list_chunks(core::RoomHandle room) override;
+    void drop_room(core::RoomHandle room) override;
+
+private:
+    struct ColdChunk {
+        core::RoomHandle room;
+        std::vector<core::StreamOrdering> orderings;
+        std::vector<core::EventHandle> event_ids;
+    };
+
+    std::shared_ptr<EventRepository> repository_;
+    std::mutex mutex_;
+    uint64_t next_chunk_id_ = 1;
+    std::unordered_map<uint64_t, ColdChunk> chunks_;
+
+    std::unique_ptr<core::Event> read_event(const core::EventID& event_id) {
+        if (auto event = repository_->read_encoded(event_id)) {
+            return event;
+        }
+        return repository_->read_by_event_id(event_id);
+    }
+};
+
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "repository.hpp"
 #include "../../core/event/event.hpp"
+#include "../../core/room/auth_chain_index.hpp"
 #include <vector>
 #include <memory>
 
@@ -20,6 +21,9 @@ public:
     virtual std::vector<std::unique_ptr<core::Event>> read_events_by_reference(const core::EventID& event_id, const std::string& relation_type = "") = 0;
 
     virtual bool create_batch(const std::vector<core::Event>& events) = 0;
+    virtual bool create_encoded(const core::Event& event) = 0;
+    virtual std::unique_ptr<core::Event> read_encoded(const core::EventID& event_id) = 0;
+    virtual std::vector<std::unique_ptr<core::Event>> read_encoded_by_room_id(const core::RoomID& room_id, int limit = 100, const std::string& since_token = "") = 0;
     virtual bool update_unsigned_data(const core::EventID& event_id, const core::UnsignedData& unsigned_data) = 0;
     virtual bool add_relation(const core::EventID& from_event, const core::EventID& to_event, const std::string& relation_type) = 0;
     virtual bool remove_relations(const core::EventID& event_id) = 0;
@@ -30,6 +34,23 @@ public:
 
     virtual int64_t get_room_event_count(const core::RoomID& room_id) = 0;
     virtual int64_t get_event_depth(const core::EventID& event_id) = 0;
+
+    struct EventEdges {
+        core::EventID event_id;
+        int64_t depth = 0;
+        std::vector<core::EventID> prev_events;
+        std::vector<core::EventID> auth_events;
+    };
+
+    virtual std::vector<EventEdges> read_room_event_edges(const core::RoomID& room_id, int64_t min_depth = 0) = 0;
+
+    // Rows are joined with events for each chain's (type, state_key). Stores
+    // skip rows and links that are already present, so a drain that is
+    // retried after a failed write does not duplicate them.
+    virtual bool read_auth_chain_index(const core::RoomID& room_id, std::vector<core::AuthChainIndex::Row>& rows,
+                                       std::vector<core::AuthChainIndex::Link>& links) = 0;
+    virtual bool store_auth_chain_index(const core::RoomID& room_id, const std::vector<core::AuthChainIndex::Row>& rows,
+                                        const std::vector<core::AuthChainIndex::Link>& links) = 0;
     virtual std::string get_latest_event_id_for_room(const core::RoomID& room_id) = 0;
 
     virtual bool delete_events_for_room(const core::RoomID& room_id) = 0;
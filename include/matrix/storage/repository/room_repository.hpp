@@ -3,8 +3,10 @@
 #include "repository.hpp"
 #include "../../core/room/room.hpp"
 #include "../../core/event/event.hpp"
+#include "../../core/state/state_group_store.hpp"
 #include <vector>
 #include <memory>
+#include <optional>
 
 namespace matrix::storage::repository {
 
@@ -69,6 +71,12 @@ public:
 
     virtual std::unique_ptr<RoomSummary> get_room_summary(const core::RoomID& room_id) = 0;
     virtual std::vector<RoomSummary> get_public_room_summaries(int limit = 100, const std::string& since_token = "") = 0;
+
+    virtual bool store_state_group(const core::StateGroupBackend::GroupRecord& record) = 0;
+    virtual std::optional<core::StateGroupBackend::GroupRecord> read_state_group(core::StateGroupId group) = 0;
+    virtual bool store_event_state_group(const core::EventID& event_id, core::StateGroupId group) = 0;
+    virtual std::optional<core::StateGroupId> read_event_state_group(const core::EventID& event_id) = 0;
+    virtual core::StateGroupId get_max_state_group() = 0;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "room_repository.hpp"
+#include "../../core/state/state_group_store.hpp"
+#include <memory>
+
+namespace matrix::storage::repository {
+
+class RoomRepositoryStateGroupBackend : public core::StateGroupBackend {
+public:
+    explicit RoomRepositoryStateGroupBackend(std::shared_ptr<RoomRepository> repository)
+        : repository_(std::move(repository)) {}
+    ~RoomRepositoryStateGroupBackend() override = default;
+
+    bool store_group(const GroupRecord& record) override { return repository_->store_state_group(record); }
+    std::optional<GroupRecord> load_group(core::StateGroupId group) override { return repository_->read_state_group(group); }
+    bool store_event_group(const core::EventID& event_id, core::StateGroupId group) override {
+        return repository_->store_event_state_group(event_id, group);
+    }
+    std::optional<core::StateGroupId> load_event_group(const core::EventID& event_id) override {
+        return repository_->read_event_state_group(event_id);
+    }
+    core::StateGroupId max_group_id() override { return repository_->get_max_state_group(); }
+
+private:
+    std::shared_ptr<RoomRepository> repository_;
+};
+
+}
\ No newline at end of file
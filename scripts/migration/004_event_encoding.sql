@@ -0,0 +1,6 @@
+ALTER TABLE events ADD COLUMN encoded BYTEA;
+ALTER TABLE events ADD COLUMN encoding_version SMALLINT;
+ALTER TABLE events ALTER COLUMN content DROP NOT NULL;
+
+ALTER TABLE events ADD CONSTRAINT events_content_or_encoded
+    CHECK (content IS NOT NULL OR encoded IS NOT NULL);
\ No newline at end of file
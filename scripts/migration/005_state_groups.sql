@@ -0,0 +1,10 @@
+CREATE TABLE event_to_state_groups (
+                                       event_id TEXT PRIMARY KEY,
+                                       state_group BIGINT NOT NULL
+);
+
+CREATE INDEX event_to_state_groups_group_idx ON event_to_state_groups (state_group);
+-- Deltas between this group and the nearest snapshot; 0 for a snapshot.
+ALTER TABLE federation_state_group_edges ADD COLUMN chain_length INTEGER NOT NULL DEFAULT 0;
+
+CREATE INDEX federation_state_group_edges_prev_idx ON federation_state_group_edges (prev_state_group);
\ No newline at end of file
@@ -0,0 +1,18 @@
+CREATE TABLE event_auth_chains (
+                                   event_id TEXT PRIMARY KEY,
+                                   room_id TEXT NOT NULL,
+                                   chain_id BIGINT NOT NULL,
+                                   sequence_number BIGINT NOT NULL
+);
+
+CREATE UNIQUE INDEX event_auth_chains_c_seq_idx ON event_auth_chains (room_id, chain_id, sequence_number);
+
+CREATE TABLE event_auth_chain_links (
+                                        room_id TEXT NOT NULL,
+                                        origin_chain_id BIGINT NOT NULL,
+                                        origin_sequence_number BIGINT NOT NULL,
+                                        target_chain_id BIGINT NOT NULL,
+                                        target_sequence_number BIGINT NOT NULL,
+                                        PRIMARY KEY (room_id, origin_chain_id, origin_sequence_number,
+                                                     target_chain_id, target_sequence_number)
+);
\ No newline at end of file
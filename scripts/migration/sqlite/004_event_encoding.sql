@@ -0,0 +1,34 @@
+-- SQLite cannot drop NOT NULL or add a CHECK constraint in place, so events
+-- is rebuilt with the encoded columns and the relaxed content column.
+
+CREATE TABLE events_new (
+                            event_id TEXT PRIMARY KEY,
+                            room_id TEXT NOT NULL,
+                            type TEXT NOT NULL,
+                            sender TEXT NOT NULL,
+                            state_key TEXT,
+                            content TEXT,
+                            origin_server_ts INTEGER NOT NULL,
+                            unsigned TEXT,
+                            redacts TEXT,
+                            depth INTEGER NOT NULL DEFAULT 0,
+                            prev_events TEXT,
+                            auth_events TEXT,
+                            created_ts TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                            encoded BLOB,
+                            encoding_version INTEGER,
+                            CHECK (content IS NOT NULL OR encoded IS NOT NULL)
+);
+
+INSERT INTO events_new (event_id, room_id, type, sender, state_key, content, origin_server_ts,
+                        unsigned, redacts, depth, prev_events, auth_events, created_ts)
+SELECT event_id, room_id, type, sender, state_key, content, origin_server_ts,
+       unsigned, redacts, depth, prev_events, auth_events, created_ts
+FROM events;
+
+DROP TABLE events;
+ALTER TABLE events_new RENAME TO events;
+
+CREATE INDEX IF NOT EXISTS idx_events_room_id ON events(room_id);
+CREATE INDEX IF NOT EXISTS idx_events_sender ON events(sender);
+CREATE INDEX IF NOT EXISTS idx_events_type ON events(type);
\ No newline at end of file
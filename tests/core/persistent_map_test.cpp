@@ -0,0 +1,115 @@
+#include "matrix/core/persistent_map.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using matrix::PersistentMap;
+
+namespace {
+
+std::map<std::string, int> contents(const PersistentMap<int>& map) {
+    std::map<std::string, int> out;
+    map.for_each([&](const std::string& key, const int& value) { out.emplace(key, value); });
+    return out;
+}
+
+void require_matches(const PersistentMap<int>& map, const std::map<std::string, int>& expected) {
+    REQUIRE(map.size() == expected.size());
+    REQUIRE(contents(map) == expected);
+    for (const auto& [key, value] : expected) {
+        const int* found = map.find(key);
+        REQUIRE(found != nullptr);
+        REQUIRE(*found == value);
+    }
+}
+
+}
+
+TEST_CASE("PersistentMap basic set, find and erase", "[persistent_map]") {
+    PersistentMap<int> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find("missing") == nullptr);
+
+    map.set("a", 1);
+    map.set("b", 2);
+    map.set("a", 3);
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.find("a") == 3);
+    REQUIRE(*map.find("b") == 2);
+
+    REQUIRE(map.erase("a"));
+    REQUIRE_FALSE(map.erase("a"));
+    REQUIRE(map.size() == 1);
+    REQUIRE(map.find("a") == nullptr);
+
+    map.clear();
+    REQUIRE(map.empty());
+}
+
+TEST_CASE("PersistentMap copies are unaffected by later writes", "[persistent_map]") {
+    PersistentMap<int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.set("key" + std::to_string(i), i);
+    }
+
+    PersistentMap<int> copy = map;
+    REQUIRE(copy.shares_root_with(map));
+
+    map.set("key0", -1);
+    map.erase("key1");
+    map.set("new", 42);
+
+    REQUIRE_FALSE(copy.shares_root_with(map));
+    REQUIRE(*copy.find("key0") == 0);
+    REQUIRE(*copy.find("key1") == 1);
+    REQUIRE(copy.find("new") == nullptr);
+    REQUIRE(copy.size() == 1000);
+    REQUIRE(map.size() == 1000);
+}
+
+TEST_CASE("PersistentMap matches std::map under random set and erase", "[persistent_map]") {
+    constexpr size_t OPERATIONS = 200000;
+    constexpr size_t SNAPSHOT_EVERY = 5000;
+
+    std::mt19937_64 rng(20240611);
+    std::uniform_int_distribution<int> key_dist(0, 20000);
+    std::uniform_int_distribution<int> op_dist(0, 2);
+
+    PersistentMap<int> map;
+    std::map<std::string, int> expected;
+    std::vector<std::pair<PersistentMap<int>, std::map<std::string, int>>> snapshots;
+
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        const std::string key = "k" + std::to_string(key_dist(rng));
+        if (op_dist(rng) == 0) {
+            const bool erased = map.erase(key);
+            REQUIRE(erased == (expected.erase(key) == 1));
+        } else {
+            const int value = static_cast<int>(i);
+            map.set(key, value);
+            expected[key] = value;
+        }
+
+        if (i % SNAPSHOT_EVERY == 0) {
+            REQUIRE(map.size() == expected.size());
+            snapshots.emplace_back(map, expected);
+        }
+    }
+
+    require_matches(map, expected);
+    for (const auto& [snapshot, snapshot_expected] : snapshots) {
+        require_matches(snapshot, snapshot_expected);
+    }
+
+    for (const auto& [key, value] : std::map<std::string, int>(expected)) {
+        REQUIRE(map.erase(key));
+    }
+    REQUIRE(map.empty());
+    REQUIRE(contents(map).empty());
+    require_matches(snapshots.back().first, snapshots.back().second);
+}
\ No newline at end of file